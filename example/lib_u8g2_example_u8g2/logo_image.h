@@ -0,0 +1,46 @@
+#pragma once
+
+/*
+  Image logo.h created by u8g2_image_pack
+  Size: 128x64 pixels, 452 bytes
+*/
+static const uint8_t e14_logo_image[452] = {
+    0x01, 0x10, 0x08, 0xFF, 0x00, 0x8D, 0x00, 0x80, 0xC0, 0x00, 0x80, 0xCB,
+    0x00, 0x80, 0xC0, 0x9C, 0x00, 0x03, 0xE0, 0xF8, 0x78, 0x18, 0x83, 0x0C,
+    0x03, 0x18, 0x38, 0xF8, 0xE0, 0x81, 0x00, 0x81, 0xFF, 0x81, 0x00, 0x03,
+    0xE0, 0xF8, 0x38, 0x1C, 0x83, 0x0C, 0x03, 0x18, 0xF8, 0xF0, 0xC0, 0x81,
+    0x00, 0x80, 0xFC, 0x02, 0x70, 0x18, 0x08, 0x82, 0x0C, 0x04, 0x18, 0xF8,
+    0xF0, 0x30, 0x18, 0x83, 0x0C, 0x02, 0x38, 0xF8, 0xE0, 0x82, 0x00, 0x02,
+    0xF0, 0xF8, 0x18, 0x84, 0x0C, 0x02, 0x18, 0xF8, 0xF0, 0x82, 0x00, 0x80,
+    0xFC, 0x02, 0x30, 0x18, 0x08, 0x82, 0x0C, 0x02, 0x1C, 0xF8, 0xF0, 0x80,
+    0x00, 0x80, 0x0C, 0x80, 0xFF, 0x00, 0x1C, 0x80, 0x0C, 0x85, 0x00, 0x80,
+    0xFC, 0x82, 0x00, 0x80, 0xFC, 0x84, 0x00, 0x80, 0xC0, 0x82, 0x00, 0x02,
+    0x3F, 0xFF, 0xE3, 0x81, 0x83, 0x00, 0x03, 0x83, 0x83, 0x00, 0x03, 0x81,
+    0x00, 0x81, 0xFF, 0x81, 0x00, 0x02, 0x7F, 0xFF, 0xC3, 0x81, 0x83, 0x00,
+    0x03, 0x82, 0x83, 0x80, 0x03, 0x81, 0x00, 0x80, 0xFF, 0x86, 0x00, 0x80,
+    0xFF, 0x86, 0x00, 0x80, 0xFF, 0x81, 0x00, 0x00, 0x0F, 0x80, 0xFF, 0x00,
+    0xC3, 0x80, 0x83, 0x00, 0x03, 0x83, 0x83, 0x00, 0x03, 0x82, 0x00, 0x80,
+    0xFF, 0x86, 0x00, 0x80, 0xFF, 0x82, 0x00, 0x02, 0x7F, 0xFF, 0xC0, 0x81,
+    0x80, 0x84, 0x00, 0x80, 0xFF, 0x82, 0x00, 0x02, 0x0F, 0x1F, 0x38, 0x80,
+    0x30, 0x81, 0x60, 0x80, 0xFF, 0x81, 0x30, 0x81, 0x00, 0x88, 0x01, 0x82,
+    0x00, 0x81, 0x01, 0x83, 0x00, 0x88, 0x01, 0x82, 0x00, 0x80, 0x01, 0x86,
+    0x00, 0x80, 0x01, 0x86, 0x00, 0x80, 0x01, 0x84, 0x00, 0x87, 0x01, 0x83,
+    0x00, 0x80, 0x01, 0x86, 0x00, 0x80, 0x01, 0x83, 0x00, 0x84, 0x01, 0x83,
+    0x00, 0x80, 0x01, 0x8A, 0x00, 0x80, 0x01, 0xA0, 0x00, 0x83, 0xFE, 0x00,
+    0x1E, 0x80, 0x06, 0x05, 0x3E, 0xFE, 0x06, 0xC6, 0x1E, 0x06, 0x81, 0xFE,
+    0x05, 0x7E, 0x0E, 0x06, 0x0E, 0x76, 0x86, 0x80, 0x1E, 0x06, 0xC6, 0xFE,
+    0x06, 0xC6, 0x1E, 0x06, 0xFE, 0x80, 0x06, 0x03, 0xD6, 0xF6, 0xFE, 0xF6,
+    0x80, 0x06, 0x00, 0xF6, 0x80, 0xFE, 0x19, 0x8E, 0x06, 0x76, 0xF6, 0x66,
+    0xFE, 0x0E, 0x66, 0xF6, 0x76, 0x06, 0x9E, 0xFE, 0x06, 0x0E, 0x3E, 0x86,
+    0x06, 0xFE, 0x06, 0x0E, 0x3E, 0x86, 0x06, 0xFE, 0x06, 0x80, 0x7E, 0x08,
+    0x06, 0xFE, 0x06, 0xC6, 0x1E, 0x06, 0xFE, 0x06, 0xFE, 0x80, 0xF6, 0x00,
+    0x06, 0x81, 0xF6, 0x02, 0xC6, 0x0E, 0xE6, 0x84, 0xFE, 0x01, 0x1E, 0x02,
+    0x9D, 0x00, 0x82, 0x07, 0x80, 0x06, 0x80, 0x07, 0x02, 0x06, 0x07, 0x06,
+    0x80, 0x07, 0x00, 0x06, 0x81, 0x07, 0x00, 0x06, 0x81, 0x07, 0x01, 0x06,
+    0x07, 0x80, 0x06, 0x80, 0x07, 0x00, 0x06, 0x80, 0x07, 0x01, 0x06, 0x07,
+    0x82, 0x06, 0x80, 0x07, 0x80, 0x06, 0x82, 0x07, 0x82, 0x06, 0x80, 0x07,
+    0x81, 0x06, 0x81, 0x07, 0x00, 0x06, 0x81, 0x07, 0x02, 0x06, 0x07, 0x06,
+    0x81, 0x07, 0x00, 0x06, 0x80, 0x07, 0x80, 0x06, 0x80, 0x07, 0x00, 0x06,
+    0x80, 0x07, 0x02, 0x06, 0x07, 0x06, 0x81, 0x07, 0x00, 0x06, 0x82, 0x07,
+    0x00, 0x06, 0x84, 0x07, 0xFF, 0x00, 0x81, 0x00
+};
@@ -48,7 +48,16 @@
 #include "epoll_timerfd_utilities.h"
 
 #include "lib_u8g2.h"
+#include "lib_u8g2_font.h"
+#include "lib_u8g2_span.h"
+#include "lib_u8g2_circle.h"
+#include "lib_u8g2_transition.h"
+#include "lib_u8g2_dirty.h"
+#include "lib_u8g2_cache.h"
+#include "lib_u8g2_stream.h"
+#include "lib_u8g2_anim.h"
 #include "logo.h"
+#include "logo_image.h"
 
 /*******************************************************************************
 *   Macros and #define Constants
@@ -62,6 +71,11 @@
 
 #define OLED_ROTATION       U8G2_R0
 
+#define SCREEN_CACHE_SIZE   (2048u)
+
+#define ANIM_FPS            (50u)
+#define FADE_IN_MS          (500u)
+
 typedef enum
 {
     SCR_LOGO,
@@ -123,10 +137,24 @@ handle_button1_press(void);
 static void
 event_handler_timer_button(EventData *event_data);
 
+/**
+ * @brief Frame timer event handler advancing animations
+ */
+static void
+event_handler_timer_anim(EventData *event_data);
+
+/**
+ * @brief Start frame timer
+ */
+static void
+start_animation(void);
 
 static void
 display_screen(screen_id_t scr_id);
 
+static void
+render_screen(u8g2_t *u8g2, uint8_t scr_id);
+
 
 /*******************************************************************************
 * Global variables
@@ -139,6 +167,7 @@ static int g_fd_epoll = -1;        // Epoll file descriptor
 static int g_fd_i2c = -1;          // I2C interface file descriptor
 static int g_fd_gpio_button1 = -1; // GPIO button1 file descriptor
 static int g_fd_poll_timer_button = -1;    // Poll timer button press file desc.
+static int g_fd_timer_anim = -1;   // Animation frame timer file descriptor
 
 static GPIO_Value_Type g_state_button1 = GPIO_Value_High;
 
@@ -146,10 +175,21 @@ static EventData g_event_data_button = {          // Button Event data
     .eventHandler = &event_handler_timer_button
 };
 
+static EventData g_event_data_anim = {            // Animation Event data
+    .eventHandler = &event_handler_timer_anim
+};
+
 static u8g2_t g_u8g2;           // OLED device descriptor for u8g2
 
 static screen_id_t g_screen_id = SCR_LOGO;  // Displayed screen id
 
+static uint8_t g_screen_cache_buf[SCREEN_CACHE_SIZE];
+static lib_u8g2_cache_t g_screen_cache;     // Pre-rendered screens
+
+static lib_u8g2_tween_t g_tween_contrast;   // Display fade in
+static int16_t g_contrast;
+static bool gb_is_sliding = false;          // Screen slide in progress
+
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
@@ -186,13 +226,25 @@ main(int argc, char *argv[])
     {
         // All handlers and peripherals are initialized properly at this point
 
-        u8g2_ClearDisplay(&g_u8g2);
+        // Fade in splash screen shown before first frame is rendered
+        lib_u8g2_SetContrastLevel(&g_u8g2, 0);
+        lib_u8g2_StreamImage(&g_u8g2, 0, 0, e14_logo_image);
+        lib_u8g2_AnimStart(&g_tween_contrast, &g_contrast, 0,
+            LIB_U8G2_TRANSITION_DEFAULT_CONTRAST, FADE_IN_MS,
+            LIB_U8G2_EASE_OUT);
+        start_animation();
+
+        // Display shows logo screen already, render it to frame buffer only
+        lib_u8g2_CacheShow(&g_u8g2, &g_screen_cache, g_screen_id, 0);
+        lib_u8g2_MarkClean(&g_u8g2);
 
-        // Main program loop
+        // Main program loop, display is updated by event handlers only
         while (!gb_is_termination_requested)
         {
-            // Update OLED display contents
-            display_screen(g_screen_id);
+            // Pre-render next screen while idle, screens are shown in sequence
+            lib_u8g2_CachePredict(&g_screen_cache,
+                (g_screen_id == SCR_GRAPHICS) ? SCR_LOGO : g_screen_id + 1, 0);
+            lib_u8g2_CacheIdle(&g_u8g2, &g_screen_cache);
 
             // Handle timers
             if (WaitForEventAndCallHandler(g_fd_epoll) != 0)
@@ -289,6 +341,18 @@ init_peripherals(void)
         u8g2_Setup_ssd1306_i2c_128x64_noname_f(&g_u8g2, OLED_ROTATION,
             lib_u8g2_byte_i2c, lib_u8g2_custom_cb);
 
+        // Use word-wide span kernels for all u8g2 drawing
+        lib_u8g2_SetSpanBackend(&g_u8g2);
+
+        // Send only areas changed by drawing
+        lib_u8g2_SetDirtyTracking(&g_u8g2);
+
+        lib_u8g2_AnimSetFrameRate(ANIM_FPS);
+
+        // Screens are rendered once and then restored from cache
+        lib_u8g2_CacheInit(&g_screen_cache, g_screen_cache_buf,
+            sizeof(g_screen_cache_buf), render_screen);
+
         // Initialize display descriptor
         u8g2_InitDisplay(&g_u8g2);
 
@@ -324,6 +388,21 @@ init_peripherals(void)
         }
     }
 
+    // Create animation frame timer, armed while animations run
+    if (result != -1)
+    {
+        struct timespec anim_period = { 0, 0 };
+
+        g_fd_timer_anim = CreateTimerFdAndAddToEpoll(g_fd_epoll,
+            &anim_period, &g_event_data_anim, EPOLLIN);
+        if (g_fd_timer_anim < 0)
+        {
+            Log_Debug("ERROR: Could not create animation timer: %s (%d).\n",
+                strerror(errno), errno);
+            result = -1;
+        }
+    }
+
     return result;
 }
 
@@ -338,6 +417,10 @@ close_peripherals_and_handlers(void)
 
     // Close button1 GPIO fd
     CloseFdAndPrintError(g_fd_gpio_button1, "Button1 GPIO");
+
+    // Close timer fds
+    CloseFdAndPrintError(g_fd_poll_timer_button, "Button poll timer");
+    CloseFdAndPrintError(g_fd_timer_anim, "Animation timer");
 }
 
 static void
@@ -348,6 +431,18 @@ handle_button1_press(void)
     {
         g_screen_id = SCR_LOGO;
     }
+
+    // Slide next screen in one step per frame, only its RAM pages are sent
+    lib_u8g2_CacheShow(&g_u8g2, &g_screen_cache, g_screen_id, 0);
+    if (lib_u8g2_TransitionStart(&g_u8g2, LIB_U8G2_TRANSITION_SLIDE_UP, 8))
+    {
+        gb_is_sliding = true;
+        start_animation();
+    }
+    else
+    {
+        display_screen(g_screen_id);
+    }
 }
 
 static void
@@ -387,45 +482,91 @@ event_handler_timer_button(EventData *event_data)
     return;
 }
 
+static void
+event_handler_timer_anim(EventData *event_data)
+{
+    struct timespec stop = { 0, 0 };
+
+    if (ConsumeTimerFdEvent(g_fd_timer_anim) != 0)
+    {
+        gb_is_termination_requested = true;
+        return;
+    }
+
+    // Late frames are dropped, tweens follow elapsed time
+    if (lib_u8g2_AnimTick())
+    {
+        lib_u8g2_SetContrastLevel(&g_u8g2, (uint8_t)g_contrast);
+    }
+
+    if (gb_is_sliding)
+    {
+        gb_is_sliding = (lib_u8g2_TransitionStep(&g_u8g2) != 0);
+    }
+
+    // No frames are needed until next animation starts
+    if (!gb_is_sliding && !lib_u8g2_AnimIsRunning())
+    {
+        SetTimerFdToPeriod(g_fd_timer_anim, &stop);
+    }
+
+    return;
+}
+
+static void
+start_animation(void)
+{
+    struct timespec period = { 0, (long)lib_u8g2_AnimGetFramePeriodNs() };
+
+    SetTimerFdToPeriod(g_fd_timer_anim, &period);
+}
+
 static void
 display_screen(screen_id_t scr_id)
 {
-    u8g2_ClearBuffer(&g_u8g2);
+    lib_u8g2_CacheShow(&g_u8g2, &g_screen_cache, scr_id, 0);
+    lib_u8g2_SendDirty(&g_u8g2);
+    return;
+}
+
+static void
+render_screen(u8g2_t *u8g2, uint8_t scr_id)
+{
+    lib_u8g2_ClearBuffer(u8g2);
 
     switch (scr_id)
     {
     case SCR_LOGO:
-        u8g2_DrawXBM(&g_u8g2, 0, 0, e14_logo_width, e14_logo_height, e14_logo_bits);
+        u8g2_DrawXBM(u8g2, 0, 0, e14_logo_width, e14_logo_height, e14_logo_bits);
         break;
 
     case SCR_FONT:
-        u8g2_SetFont(&g_u8g2, u8g2_font_oldwizard_tr);
-        lib_u8g2_DrawCenteredStr(&g_u8g2, 10, "element14");
+        u8g2_SetFont(u8g2, u8g2_font_oldwizard_tr);
+        lib_u8g2_DrawCenteredStr(u8g2, 10, "element14");
 
-        u8g2_SetFont(&g_u8g2, u8g2_font_t0_22b_tr);
-        lib_u8g2_DrawCenteredStr(&g_u8g2, 30, "element14");
+        u8g2_SetFont(u8g2, u8g2_font_t0_22b_tr);
+        lib_u8g2_DrawCenteredStr(u8g2, 30, "element14");
 
-        u8g2_SetFont(&g_u8g2, u8g2_font_helvB18_tr);
-        lib_u8g2_DrawCenteredStr(&g_u8g2, 60, "element14");
+        u8g2_SetFont(u8g2, u8g2_font_helvB18_tr);
+        lib_u8g2_DrawCenteredStr(u8g2, 60, "element14");
         break;
 
     case SCR_GRAPHICS:
-        u8g2_DrawBox(&g_u8g2, 0, 0, 30, 20);
-        u8g2_DrawFrame(&g_u8g2, 98, 0, 30, 20);
-        u8g2_DrawDisc(&g_u8g2, 64, 32, 20, U8G2_DRAW_UPPER_RIGHT | U8G2_DRAW_LOWER_LEFT);
-        u8g2_DrawCircle(&g_u8g2, 64, 32, 30, U8G2_DRAW_ALL);
-        u8g2_DrawFrame(&g_u8g2, 0, 44, 30, 20);
-        u8g2_DrawBox(&g_u8g2, 98, 44, 30, 20);
-
-        u8g2_SetFont(&g_u8g2, u8g2_font_unifont_t_symbols);
-        u8g2_DrawGlyph(&g_u8g2, 106, 18, 0x2603);	/* dec 9731/hex 2603 Snowman */
+        lib_u8g2_DrawBox(u8g2, 0, 0, 30, 20);
+        lib_u8g2_DrawFrame(u8g2, 98, 0, 30, 20);
+        lib_u8g2_DrawDisc(u8g2, 64, 32, 20, U8G2_DRAW_UPPER_RIGHT | U8G2_DRAW_LOWER_LEFT);
+        lib_u8g2_DrawCircle(u8g2, 64, 32, 30, U8G2_DRAW_ALL);
+        lib_u8g2_DrawFrame(u8g2, 0, 44, 30, 20);
+        lib_u8g2_DrawBox(u8g2, 98, 44, 30, 20);
+
+        lib_u8g2_SetFont(u8g2, u8g2_font_unifont_t_symbols);
+        lib_u8g2_DrawGlyph(u8g2, 106, 18, 0x2603);	/* dec 9731/hex 2603 Snowman */
         break;
 
     default:
         break;
     }
 
-    u8g2_SendBuffer(&g_u8g2);
     return;
 }
 
@@ -24,6 +24,25 @@ extern "C" {
 #define I2C_STRUCTS_VERSION 1
 #include <applibs/i2c.h>
 
+/**
+ * @brief Display point, coordinates may lie outside of display.
+ */
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+} lib_u8g2_point_t;
+
+/**
+ * @brief Benchmark result, time of the same workload drawn by u8g2 and by
+ *        functions of this library.
+ */
+typedef struct
+{
+    uint32_t u8g2_us;
+    uint32_t lib_us;
+} lib_u8g2_bench_t;
+
 /**
  * @brief Set OLED display I2C interface file descriptor and address
  *
@@ -0,0 +1,133 @@
+/***************************************************************************//**
+* @file    lib_u8g2_anim.h
+* @version 1.0.0
+*
+* @brief Frame paced animation of values.
+*
+* Tweens move an application variable, e.g. position, displayed value or
+* contrast, from start to end value over given time. lib_u8g2_AnimTick()
+* is called from a periodic frame timer (timerfd with frame period). Values
+* are computed from elapsed time, not from number of ticks, so when drawing
+* and sending a frame takes longer than frame period, late frames are
+* dropped and animation keeps its duration instead of queuing frames.
+*
+* Tick reports whether any value changed, application renders only then
+* and stops frame timer when no tween is running.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_ANIM_H
+#define LIB_U8G2_ANIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Frame rate used until lib_u8g2_AnimSetFrameRate() is called.
+ */
+#ifndef LIB_U8G2_ANIM_DEFAULT_FPS
+#define LIB_U8G2_ANIM_DEFAULT_FPS           (30u)
+#endif
+
+/**
+ * @brief Easing curves.
+ */
+typedef enum
+{
+    LIB_U8G2_EASE_LINEAR,
+    LIB_U8G2_EASE_IN,       // Accelerating
+    LIB_U8G2_EASE_OUT,      // Decelerating
+    LIB_U8G2_EASE_IN_OUT
+} lib_u8g2_ease_t;
+
+/**
+ * @brief Tween, fields are private to the module.
+ */
+typedef struct lib_u8g2_tween_s
+{
+    struct lib_u8g2_tween_s *p_next;
+    int16_t *p_value;
+    int16_t from;
+    int16_t to;
+    uint32_t start_ms;
+    uint32_t duration_ms;
+    lib_u8g2_ease_t ease;
+    uint8_t is_running;
+} lib_u8g2_tween_t;
+
+/**
+ * @brief Set target frame rate.
+ *
+ * @param fps Frames per second.
+ */
+void
+lib_u8g2_AnimSetFrameRate(uint16_t fps);
+
+/**
+ * @brief Get frame period in nanoseconds, use as frame timer period.
+ */
+uint32_t
+lib_u8g2_AnimGetFramePeriodNs(void);
+
+/**
+ * @brief Start tween, restarts it if already running.
+ *
+ * Variable is set to start value immediately.
+ *
+ * @param p_tween Tween owned by application.
+ * @param p_value Animated variable.
+ * @param from Start value.
+ * @param to End value.
+ * @param duration_ms Duration in milliseconds.
+ * @param ease Easing curve.
+ */
+void
+lib_u8g2_AnimStart(lib_u8g2_tween_t *p_tween, int16_t *p_value,
+    int16_t from, int16_t to, uint32_t duration_ms, lib_u8g2_ease_t ease);
+
+/**
+ * @brief Stop tween, variable keeps current value.
+ */
+void
+lib_u8g2_AnimStop(lib_u8g2_tween_t *p_tween);
+
+/**
+ * @brief Check if any tween is running.
+ */
+uint8_t
+lib_u8g2_AnimIsRunning(void);
+
+/**
+ * @brief Advance tweens to current time, call on frame timer event.
+ *
+ * Ticks arriving before next frame deadline are ignored.
+ *
+ * @return 1 if any animated value changed, 0 otherwise.
+ */
+uint8_t
+lib_u8g2_AnimTick(void);
+
+/**
+ * @brief Advance tweens to given time in milliseconds.
+ */
+uint8_t
+lib_u8g2_AnimTickAt(uint32_t now_ms);
+
+/**
+ * @brief Get number of frames dropped since start.
+ */
+uint32_t
+lib_u8g2_AnimGetDropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_ANIM_H
+
+/* [] END OF FILE */
@@ -0,0 +1,114 @@
+/***************************************************************************//**
+* @file    lib_u8g2_batch.h
+* @version 1.0.0
+*
+* @brief Batched drawing of pixels, bars, line strips and boxes.
+*
+* Each function draws a whole series with a single call. Draw color and
+* clipping are evaluated once per batch (see lib_u8g2_SpanBegin()), lines
+* are emitted as horizontal or vertical runs instead of single pixels.
+* Coordinates may lie outside of display, invisible parts are clipped.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_BATCH_H
+#define LIB_U8G2_BATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * @brief Box given by top left corner and size.
+ */
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+} lib_u8g2_box_t;
+
+/**
+ * @brief Draw array of pixels.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param points Array of pixel positions.
+ * @param count Number of pixels.
+ */
+void
+lib_u8g2_DrawPixels(u8g2_t *u8g2, const lib_u8g2_point_t *points,
+    uint16_t count);
+
+/**
+ * @brief Draw bar chart.
+ *
+ * Bar i is bar_w pixels wide, starts at column x + i * pitch and covers
+ * rows between y_values[i] and y_base. Row y_base itself is not covered,
+ * so value equal to y_base draws nothing. Values above y_base (smaller
+ * row) draw bars growing up over rows y_values[i] to y_base - 1, values
+ * below y_base bars growing down over rows y_base + 1 to y_values[i].
+ * Bars of equal height therefore have equal size in both directions.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param x First bar column.
+ * @param y_base Bar base row.
+ * @param bar_w Bar width.
+ * @param pitch Distance between bar starts.
+ * @param y_values Array of bar top rows.
+ * @param count Number of bars.
+ */
+void
+lib_u8g2_DrawVBars(u8g2_t *u8g2, int16_t x, int16_t y_base, int16_t bar_w,
+    int16_t pitch, const int16_t *y_values, uint16_t count);
+
+/**
+ * @brief Draw connected line segments.
+ *
+ * Segments use the same pixels as u8g2_DrawLine(). Shared vertices are
+ * drawn once, so strips drawn with XOR color keep their joints.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param points Array of strip vertices.
+ * @param count Number of vertices.
+ */
+void
+lib_u8g2_DrawLineStrip(u8g2_t *u8g2, const lib_u8g2_point_t *points,
+    uint16_t count);
+
+/**
+ * @brief Draw trace of samples, one sample per column.
+ *
+ * Same as line strip through points (x + i, y_values[i]).
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param x Column of the first sample.
+ * @param y_values Array of sample rows.
+ * @param count Number of samples.
+ */
+void
+lib_u8g2_DrawTrace(u8g2_t *u8g2, int16_t x, const int16_t *y_values,
+    uint16_t count);
+
+/**
+ * @brief Draw array of filled boxes.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param boxes Array of boxes.
+ * @param count Number of boxes.
+ */
+void
+lib_u8g2_DrawBoxes(u8g2_t *u8g2, const lib_u8g2_box_t *boxes,
+    uint16_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_BATCH_H
+
+/* [] END OF FILE */
@@ -0,0 +1,153 @@
+/***************************************************************************//**
+* @file    lib_u8g2_cache.h
+* @version 1.0.0
+*
+* @brief Cache of pre-rendered screens.
+*
+* Rendered frame buffers are stored in application buffer, run length
+* compressed when it saves space, and keyed by screen id and content
+* version. Showing a cached screen is a decompression into frame buffer
+* instead of running its draw calls. Least recently used screens are
+* evicted when the buffer is full.
+*
+* Application may predict the next screen, lib_u8g2_CacheIdle() then
+* renders it in idle time so that the next switch hits the cache.
+*
+* Requires full frame buffer. Frame buffer changes are reported to dirty
+* area tracking if it is active.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_CACHE_H
+#define LIB_U8G2_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Maximum number of cached screens.
+ */
+#ifndef LIB_U8G2_CACHE_ENTRIES
+#define LIB_U8G2_CACHE_ENTRIES              (4u)
+#endif
+
+/**
+ * @brief Screen render callback, draws whole screen to cleared buffer.
+ */
+typedef void (*lib_u8g2_render_cb)(u8g2_t *u8g2, uint8_t screen_id);
+
+/**
+ * @brief Cached screen, fields are private to the module.
+ */
+typedef struct
+{
+    uint16_t offset;        // Data position in cache buffer
+    uint16_t len;           // Data length, zero if entry is free
+    uint16_t version;
+    uint16_t last_use;
+    uint8_t screen_id;
+    uint8_t is_rle;
+} lib_u8g2_cache_entry_t;
+
+/**
+ * @brief Screen cache, fields are private to the module.
+ */
+typedef struct
+{
+    uint8_t *p_buf;
+    uint16_t size;
+    uint16_t used;          // Entry data is packed from buffer start
+    uint16_t use_cnt;
+    lib_u8g2_render_cb render;
+    lib_u8g2_cache_entry_t entries[LIB_U8G2_CACHE_ENTRIES];
+    uint8_t shown_id;       // Screen held in frame buffer
+    uint16_t shown_version;
+    uint8_t is_shown;
+    uint8_t next_id;        // Predicted screen
+    uint16_t next_version;
+    uint8_t is_next;
+} lib_u8g2_cache_t;
+
+/**
+ * @brief Initialize empty cache using given buffer.
+ *
+ * @param p_cache Cache.
+ * @param p_buf Buffer for screen data.
+ * @param size Buffer size.
+ * @param render Callback rendering screens.
+ */
+void
+lib_u8g2_CacheInit(lib_u8g2_cache_t *p_cache, uint8_t *p_buf, uint16_t size,
+    lib_u8g2_render_cb render);
+
+/**
+ * @brief Put screen to frame buffer from cache, render it on cache miss.
+ *
+ * Nothing is done if frame buffer already holds the screen. Frame buffer
+ * is not sent.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param p_cache Cache.
+ * @param screen_id Screen id.
+ * @param version Screen content version.
+ *
+ * @return 1 if frame buffer was changed, 0 otherwise.
+ */
+uint8_t
+lib_u8g2_CacheShow(u8g2_t *u8g2, lib_u8g2_cache_t *p_cache,
+    uint8_t screen_id, uint16_t version);
+
+/**
+ * @brief Store frame buffer content as given screen.
+ *
+ * @return 1 on success, 0 if it does not fit into cache.
+ */
+uint8_t
+lib_u8g2_CacheStore(u8g2_t *u8g2, lib_u8g2_cache_t *p_cache,
+    uint8_t screen_id, uint16_t version);
+
+/**
+ * @brief Remove all versions of screen from cache.
+ */
+void
+lib_u8g2_CacheInvalidate(lib_u8g2_cache_t *p_cache, uint8_t screen_id);
+
+/**
+ * @brief Notify cache that frame buffer was changed by other drawing.
+ */
+void
+lib_u8g2_CacheForgetShown(lib_u8g2_cache_t *p_cache);
+
+/**
+ * @brief Set screen likely to be shown next.
+ */
+void
+lib_u8g2_CachePredict(lib_u8g2_cache_t *p_cache, uint8_t screen_id,
+    uint16_t version);
+
+/**
+ * @brief Render predicted screen to cache, call when application is idle.
+ *
+ * Frame buffer is used for rendering and restored from cache afterwards,
+ * prediction is skipped unless frame buffer holds a cached screen.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param p_cache Cache.
+ *
+ * @return 1 if a screen was rendered, 0 otherwise.
+ */
+uint8_t
+lib_u8g2_CacheIdle(u8g2_t *u8g2, lib_u8g2_cache_t *p_cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_CACHE_H
+
+/* [] END OF FILE */
@@ -0,0 +1,110 @@
+/***************************************************************************//**
+* @file    lib_u8g2_chart.h
+* @version 1.0.0
+*
+* @brief Scrolling sparkline charts of live samples.
+*
+* Chart keeps samples in a ring buffer of chart width, newest sample is
+* shown in the rightmost column. A new sample shifts chart area one column
+* left and draws only the new column. With hardware scrolling, chart is
+* scrolled by lib_u8g2_ScrollWindow() and sent immediately. If content
+* scroll is enabled by LIB_U8G2_SCROLL_MAX_HW_STEPS (SSD1306B and SSD1309
+* only), display content is moved by the controller and only the new column
+* is sent, a few bytes per sample, otherwise whole chart area is sent.
+* Without hardware scrolling, frame buffer is shifted and chart area is
+* marked dirty for lib_u8g2_SendDirty().
+*
+* Chart area is page aligned, y and h are multiples of 8. Drawing ignores
+* u8g2 clip window and draw color. Requires full frame buffer with vertical
+* byte layout and U8G2_R0 rotation.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_CHART_H
+#define LIB_U8G2_CHART_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * @brief Chart styles.
+ */
+typedef enum
+{
+    LIB_U8G2_CHART_LINE,    // Samples connected by vertical segments
+    LIB_U8G2_CHART_BAR      // Columns filled from bottom to sample
+} lib_u8g2_chart_style_t;
+
+/**
+ * @brief Chart, fields are private to the module.
+ */
+typedef struct
+{
+    int16_t *p_samples;     // Ring buffer of w samples
+    uint16_t count;
+    uint16_t next;          // Index of next sample
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+    int16_t min;            // Value shown in bottom row
+    int16_t max;            // Value shown in top row
+    lib_u8g2_chart_style_t style;
+    uint8_t is_hw_scroll;
+} lib_u8g2_chart_t;
+
+/**
+ * @brief Initialize empty chart.
+ *
+ * @param p_chart Chart.
+ * @param p_samples Sample buffer of w values.
+ * @param x Left column.
+ * @param y Top row, multiple of 8.
+ * @param w Width in columns, equal to number of shown samples.
+ * @param h Height, multiple of 8.
+ * @param min Value shown in bottom row, lower values are clamped.
+ * @param max Value shown in top row, higher values are clamped.
+ * @param style Chart style.
+ * @param is_hw_scroll 1 to scroll by lib_u8g2_ScrollWindow() and send
+ *                     immediately, 0 to mark chart dirty.
+ */
+void
+lib_u8g2_ChartInit(lib_u8g2_chart_t *p_chart, int16_t *p_samples, int16_t x,
+    int16_t y, int16_t w, int16_t h, int16_t min, int16_t max,
+    lib_u8g2_chart_style_t style, uint8_t is_hw_scroll);
+
+/**
+ * @brief Redraw whole chart to frame buffer and mark it dirty.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param p_chart Chart.
+ *
+ * @return 1 on success, 0 if frame buffer or chart area is not supported.
+ */
+uint8_t
+lib_u8g2_ChartDraw(u8g2_t *u8g2, lib_u8g2_chart_t *p_chart);
+
+/**
+ * @brief Add sample, shift chart and draw new column.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param p_chart Chart.
+ * @param value Sample value.
+ *
+ * @return 1 on success, 0 if frame buffer or chart area is not supported.
+ */
+uint8_t
+lib_u8g2_ChartPush(u8g2_t *u8g2, lib_u8g2_chart_t *p_chart, int16_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_CHART_H
+
+/* [] END OF FILE */
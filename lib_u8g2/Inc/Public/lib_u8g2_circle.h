@@ -0,0 +1,89 @@
+/***************************************************************************//**
+* @file    lib_u8g2_circle.h
+* @version 1.0.0
+*
+* @brief Span based circle, ellipse and rounded box rasteriser.
+*
+* u8g2 draws circles as many short per-octant lines. Functions in this
+* module compute per column extents of the shape once (cached for the last
+* used radius) and fill each column with a single vertical span, which sets
+* whole bytes of vertical byte buffers. Pixel output of discs, circles and
+* rounded boxes matches u8g2, U8G2_DRAW_* quadrant options are supported.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_CIRCLE_H
+#define LIB_U8G2_CIRCLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Largest radius handled by span rasteriser, bigger shapes are drawn by u8g2.
+ */
+#ifndef LIB_U8G2_CIRCLE_MAX_RADIUS
+#define LIB_U8G2_CIRCLE_MAX_RADIUS          (127u)
+#endif
+
+/**
+ * @brief Draw filled circle, replacement for u8g2_DrawDisc().
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param x0 Center x coordinate.
+ * @param y0 Center y coordinate.
+ * @param rad Radius.
+ * @param option U8G2_DRAW_* quadrant mask.
+ */
+void
+lib_u8g2_DrawDisc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0,
+    u8g2_uint_t rad, uint8_t option);
+
+/**
+ * @brief Draw circle outline, replacement for u8g2_DrawCircle().
+ */
+void
+lib_u8g2_DrawCircle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0,
+    u8g2_uint_t rad, uint8_t option);
+
+/**
+ * @brief Draw filled ellipse, replacement for u8g2_DrawFilledEllipse().
+ */
+void
+lib_u8g2_DrawFilledEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0,
+    u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option);
+
+/**
+ * @brief Draw ellipse outline, replacement for u8g2_DrawEllipse().
+ */
+void
+lib_u8g2_DrawEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0,
+    u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option);
+
+/**
+ * @brief Draw filled rounded box, replacement for u8g2_DrawRBox().
+ *
+ * Radius is reduced if box is smaller than 2 * (r + 1) in any direction.
+ */
+void
+lib_u8g2_DrawRBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    u8g2_uint_t w, u8g2_uint_t h, u8g2_uint_t r);
+
+/**
+ * @brief Draw rounded box outline, replacement for u8g2_DrawRFrame().
+ */
+void
+lib_u8g2_DrawRFrame(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    u8g2_uint_t w, u8g2_uint_t h, u8g2_uint_t r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_CIRCLE_H
+
+/* [] END OF FILE */
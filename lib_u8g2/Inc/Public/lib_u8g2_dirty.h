@@ -0,0 +1,147 @@
+/***************************************************************************//**
+* @file    lib_u8g2_dirty.h
+* @version 1.0.0
+*
+* @brief Automatic dirty area tracking of draw calls.
+*
+* Tracking wraps u8g2 low level line callback, so every u8g2 drawing
+* function records its area. Span based functions of this library record
+* their areas directly. lib_u8g2_SendDirty() then sends tiles covering the
+* bounding box of changes since the last send, instead of whole buffer.
+*
+* Immediate mode code clearing and redrawing the whole screen only needs
+* to replace u8g2_ClearBuffer() by lib_u8g2_ClearBuffer() and
+* u8g2_SendBuffer() by lib_u8g2_SendDirty(). Cleared area is the bounding
+* box of content drawn since the previous clear.
+*
+* Requires full frame buffer. Send dirty area before scrolling frame buffer
+* by lib_u8g2_scroll.h functions.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_DIRTY_H
+#define LIB_U8G2_DIRTY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Set to 1 to compare dirty tiles with copy of last sent content and skip
+ * unchanged tiles. Frame buffers up to LIB_U8G2_DIRTY_SHADOW_SIZE bytes are
+ * compared. All display updates must then go through lib_u8g2_SendDirty(),
+ * call lib_u8g2_InvalidateDirty() after sending by other means.
+ */
+#ifndef LIB_U8G2_DIRTY_COMPARE
+#define LIB_U8G2_DIRTY_COMPARE              (0)
+#endif
+
+#ifndef LIB_U8G2_DIRTY_SHADOW_SIZE
+#define LIB_U8G2_DIRTY_SHADOW_SIZE          (1024u)
+#endif
+
+/**
+ * @brief Start dirty area tracking.
+ *
+ * Call after u8g2_Setup_...() and lib_u8g2_SetSpanBackend(). Whole display
+ * is dirty initially.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ */
+void
+lib_u8g2_SetDirtyTracking(u8g2_t *u8g2);
+
+/**
+ * @brief Low level line callback recording drawn area.
+ */
+void
+lib_u8g2_dirty_ll_hvline(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    u8g2_uint_t len, uint8_t dir);
+
+/**
+ * @brief Get low level line callback wrapped by tracking.
+ *
+ * @return Wrapped callback, NULL if tracking is not active.
+ */
+u8g2_draw_ll_hvline_cb
+lib_u8g2_GetTrackedHvline(void);
+
+/**
+ * @brief Record area x0 <= x < x1, y0 <= y < y1 changed in frame buffer.
+ *
+ * For code writing to frame buffer directly, no-op if tracking is not
+ * active.
+ */
+void
+lib_u8g2_MarkDirty(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1,
+    int16_t y1);
+
+/**
+ * @brief Suspend tracking while drawing to off-screen content.
+ *
+ * While paused, draw calls and lib_u8g2_ClearBuffer() do not change
+ * recorded areas. Frame buffer must hold the same picture when tracking is
+ * resumed.
+ *
+ * @param is_paused 1 to pause tracking, 0 to resume it.
+ */
+void
+lib_u8g2_PauseDirty(uint8_t is_paused);
+
+/**
+ * @brief Get dirty area x0 <= x < x1, y0 <= y < y1 clipped to display.
+ *
+ * Whole display is reported if tracking is not active.
+ *
+ * @return 1 if dirty area is not empty, 0 otherwise.
+ */
+uint8_t
+lib_u8g2_GetDirtyArea(u8g2_t *u8g2, int16_t *p_x0, int16_t *p_y0,
+    int16_t *p_x1, int16_t *p_y1);
+
+/**
+ * @brief Mark whole display dirty.
+ */
+void
+lib_u8g2_InvalidateDirty(u8g2_t *u8g2);
+
+/**
+ * @brief Mark display up to date with frame buffer, nothing is sent.
+ *
+ * For pictures put to display by other means, e.g. boot splash streamed by
+ * lib_u8g2_StreamImage() and the same picture rendered to frame buffer.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ */
+void
+lib_u8g2_MarkClean(u8g2_t *u8g2);
+
+/**
+ * @brief Clear frame buffer, replacement for u8g2_ClearBuffer().
+ *
+ * @param u8g2 u8g2 display descriptor.
+ */
+void
+lib_u8g2_ClearBuffer(u8g2_t *u8g2);
+
+/**
+ * @brief Send tiles covering dirty area, replacement for u8g2_SendBuffer().
+ *
+ * @param u8g2 u8g2 display descriptor.
+ *
+ * @return 1 if anything was sent, 0 otherwise.
+ */
+uint8_t
+lib_u8g2_SendDirty(u8g2_t *u8g2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_DIRTY_H
+
+/* [] END OF FILE */
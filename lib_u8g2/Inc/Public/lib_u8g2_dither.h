@@ -0,0 +1,88 @@
+/***************************************************************************//**
+* @file    lib_u8g2_dither.h
+* @version 1.0.0
+*
+* @brief Grayscale images dithered into frame buffer.
+*
+* Images with 8 bit pixel levels, e.g. camera thumbnails or downloaded
+* pictures, are converted to 1 bit pixels directly in page-major frame
+* buffer. Image rows are requested one by one from a row source callback,
+* whole grayscale image never needs to be in memory. Level 0 is a dark
+* pixel, 255 a lit pixel.
+*
+* Ordered dithering by 8x8 Bayer matrix is fastest and its pattern stays
+* anchored to the display when image moves. Floyd-Steinberg error diffusion
+* keeps most detail, Atkinson diffusion gives higher contrast and cleaner
+* flat areas. Error diffusion uses fixed point arithmetic and static error
+* rows of LIB_U8G2_DITHER_MAX_WIDTH columns.
+*
+* Image pixels replace frame buffer pixels, draw color is ignored. Drawing
+* ignores u8g2 clip window. Requires full frame buffer with vertical byte
+* layout and U8G2_R0 rotation.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_DITHER_H
+#define LIB_U8G2_DITHER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Maximum image width, error diffusion takes 6 bytes per column of static
+ * memory.
+ */
+#ifndef LIB_U8G2_DITHER_MAX_WIDTH
+#define LIB_U8G2_DITHER_MAX_WIDTH           (128u)
+#endif
+
+/**
+ * @brief Dithering methods.
+ */
+typedef enum
+{
+    LIB_U8G2_DITHER_BAYER,
+    LIB_U8G2_DITHER_FLOYD_STEINBERG,
+    LIB_U8G2_DITHER_ATKINSON
+} lib_u8g2_dither_t;
+
+/**
+ * @brief Row source, returns image row of width levels, NULL on failure.
+ *
+ * Rows are requested in order from 0, returned row must stay valid until
+ * next call.
+ */
+typedef const uint8_t *(*lib_u8g2_row_source_cb)(void *p_ctx, uint16_t row);
+
+/**
+ * @brief Dither image into frame buffer and mark it dirty.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param x Left column of image.
+ * @param y Top row of image.
+ * @param w Image width, at most LIB_U8G2_DITHER_MAX_WIDTH.
+ * @param h Image height.
+ * @param method Dithering method.
+ * @param source Row source.
+ * @param p_ctx Row source context.
+ *
+ * @return 1 on success, 0 if frame buffer or width is not supported or row
+ *         source failed.
+ */
+uint8_t
+lib_u8g2_DitherImage(u8g2_t *u8g2, int16_t x, int16_t y, uint16_t w,
+    uint16_t h, lib_u8g2_dither_t method, lib_u8g2_row_source_cb source,
+    void *p_ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_DITHER_H
+
+/* [] END OF FILE */
@@ -0,0 +1,145 @@
+/***************************************************************************//**
+* @file    lib_u8g2_dlist.h
+* @version 1.0.0
+*
+* @brief Display list recording and per page replay.
+*
+* In page buffer mode (u8g2_Setup_..._1() and _2() functions) drawing code
+* runs once per page. Display list records draw calls once into compact
+* bytecode held in application buffer and replays it for each page. Every
+* draw command stores rows it covers, commands not touching current page
+* are skipped without drawing.
+*
+* Strings are copied into the list, fonts and bitmaps are referenced. Text
+* rows are estimated from font bounding box, fonts are expected to use
+* baseline position and no rotation (u8g2 defaults).
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_DLIST_H
+#define LIB_U8G2_DLIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * @brief Display list.
+ */
+typedef struct
+{
+    uint8_t *p_buf;         // Bytecode buffer
+    uint16_t size;          // Buffer size
+    uint16_t len;           // Bytes used
+    const uint8_t *font;    // Font of recorded text commands
+    uint8_t is_overflow;    // Set if a command did not fit and was dropped
+} lib_u8g2_dlist_t;
+
+/**
+ * @brief Initialize empty display list using given buffer.
+ */
+void
+lib_u8g2_DlInit(lib_u8g2_dlist_t *p_dl, uint8_t *p_buf, uint16_t size);
+
+/**
+ * @brief Remove all commands.
+ */
+void
+lib_u8g2_DlClear(lib_u8g2_dlist_t *p_dl);
+
+/**
+ * @brief Replay display list to current page.
+ *
+ * Use inside u8g2_FirstPage() / u8g2_NextPage() loop, works also with full
+ * frame buffer.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param p_dl Display list.
+ */
+void
+lib_u8g2_DlReplay(u8g2_t *u8g2, const lib_u8g2_dlist_t *p_dl);
+
+/**
+ * @brief Draw all pages from display list and send them to display.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param p_dl Display list.
+ */
+void
+lib_u8g2_DlSend(u8g2_t *u8g2, const lib_u8g2_dlist_t *p_dl);
+
+/*
+ * Recording functions, counterparts of u8g2 functions with the same name.
+ */
+
+void
+lib_u8g2_DlSetDrawColor(lib_u8g2_dlist_t *p_dl, uint8_t color);
+
+void
+lib_u8g2_DlSetFont(lib_u8g2_dlist_t *p_dl, const uint8_t *font);
+
+void
+lib_u8g2_DlDrawPixel(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y);
+
+void
+lib_u8g2_DlDrawHLine(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    int16_t w);
+
+void
+lib_u8g2_DlDrawVLine(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    int16_t h);
+
+void
+lib_u8g2_DlDrawLine(lib_u8g2_dlist_t *p_dl, int16_t x0, int16_t y0,
+    int16_t x1, int16_t y1);
+
+void
+lib_u8g2_DlDrawBox(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y, int16_t w,
+    int16_t h);
+
+void
+lib_u8g2_DlDrawFrame(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    int16_t w, int16_t h);
+
+void
+lib_u8g2_DlDrawRBox(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    int16_t w, int16_t h, int16_t r);
+
+void
+lib_u8g2_DlDrawRFrame(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    int16_t w, int16_t h, int16_t r);
+
+void
+lib_u8g2_DlDrawDisc(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    int16_t r, uint8_t option);
+
+void
+lib_u8g2_DlDrawCircle(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    int16_t r, uint8_t option);
+
+void
+lib_u8g2_DlDrawXBM(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y, int16_t w,
+    int16_t h, const uint8_t *bitmap);
+
+void
+lib_u8g2_DlDrawGlyph(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    uint16_t encoding);
+
+/**
+ * @brief Record UTF-8 string, at most 240 bytes are recorded.
+ */
+void
+lib_u8g2_DlDrawUTF8(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    const char *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_DLIST_H
+
+/* [] END OF FILE */
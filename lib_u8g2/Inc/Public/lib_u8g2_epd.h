@@ -0,0 +1,156 @@
+/***************************************************************************//**
+* @file    lib_u8g2_epd.h
+* @version 1.0.0
+*
+* @brief Partial refresh manager for IL3820 and SSD1607 e-paper displays.
+*
+* Full e-paper refresh flashes the panel and takes seconds, partial refresh
+* is fast but leaves ghosting which grows with each update. The manager
+* sends only dirty tiles recorded by lib_u8g2_dirty.h and refreshes them
+* by partial waveform. Full refresh is scheduled once number of partial
+* refreshes or area refreshed by them since the last full refresh reaches
+* its threshold.
+*
+* Refresh is not waited for. lib_u8g2_EpdUpdate() starts it and returns,
+* lib_u8g2_EpdPoll() called from a periodic timerfd handler of the epoll
+* loop reports its completion. Drawing may continue while refresh runs,
+* changes are sent by the next update.
+*
+* Controller commands and BUSY pin are accessed through a transport. The
+* built-in transport lib_u8g2_epd_ssd16xx drives IL3820 and SSD1607 panels
+* set up by u8g2_Setup_il3820_...() or u8g2_Setup_ssd1607_...(), tests
+* can provide a mock transport recording refresh types.
+*
+* Requires full frame buffer and dirty area tracking.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_EPD_H
+#define LIB_U8G2_EPD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Default ghosting thresholds, number of partial refreshes and refreshed
+ * area in percent of display area.
+ */
+#ifndef LIB_U8G2_EPD_MAX_PARTIAL
+#define LIB_U8G2_EPD_MAX_PARTIAL            (20u)
+#endif
+
+#ifndef LIB_U8G2_EPD_MAX_PARTIAL_AREA
+#define LIB_U8G2_EPD_MAX_PARTIAL_AREA       (300u)
+#endif
+
+/**
+ * @brief Refresh types, also returned by lib_u8g2_EpdUpdate().
+ */
+typedef enum
+{
+    LIB_U8G2_EPD_NONE,      // Nothing to refresh
+    LIB_U8G2_EPD_BUSY,      // Previous refresh still running
+    LIB_U8G2_EPD_PARTIAL,
+    LIB_U8G2_EPD_FULL
+} lib_u8g2_epd_refresh_t;
+
+/**
+ * @brief Controller access.
+ */
+typedef struct
+{
+    // Start refresh of controller RAM content, must not wait for its end
+    void (*start_refresh)(u8g2_t *u8g2, lib_u8g2_epd_refresh_t type);
+
+    // Check if refresh is running
+    uint8_t (*is_busy)(u8g2_t *u8g2);
+} lib_u8g2_epd_transport_t;
+
+/**
+ * @brief Refresh manager, fields are private to the module.
+ */
+typedef struct
+{
+    const lib_u8g2_epd_transport_t *p_transport;
+    uint8_t max_partial;
+    uint16_t max_area;      // Percent of display area
+    uint8_t partial_cnt;    // Partial refreshes since last full refresh
+    uint32_t partial_area;  // Pixels refreshed by them
+    uint8_t is_full_requested;
+    lib_u8g2_epd_refresh_t running;
+    int16_t x0;             // Area of running refresh
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+} lib_u8g2_epd_t;
+
+/**
+ * Transport for IL3820 and SSD1607 controllers, uses BUSY pin set by
+ * lib_u8g2_EpdSetBusyGpio().
+ */
+extern const lib_u8g2_epd_transport_t lib_u8g2_epd_ssd16xx;
+
+/**
+ * @brief Set BUSY pin used by built-in transport.
+ *
+ * @param fd_busy GPIO file descriptor opened as input.
+ */
+void
+lib_u8g2_EpdSetBusyGpio(int fd_busy);
+
+/**
+ * @brief Initialize refresh manager, first refresh is full.
+ *
+ * @param p_epd Refresh manager.
+ * @param p_transport Controller access.
+ * @param max_partial Partial refreshes allowed between full refreshes.
+ * @param max_area Area of partial refreshes allowed between full
+ *                 refreshes, in percent of display area.
+ */
+void
+lib_u8g2_EpdInit(lib_u8g2_epd_t *p_epd,
+    const lib_u8g2_epd_transport_t *p_transport, uint8_t max_partial,
+    uint16_t max_area);
+
+/**
+ * @brief Make next refresh full, e.g. after screen change.
+ */
+void
+lib_u8g2_EpdRequestFull(lib_u8g2_epd_t *p_epd);
+
+/**
+ * @brief Send dirty area and start its refresh.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param p_epd Refresh manager.
+ *
+ * @return Type of started refresh, LIB_U8G2_EPD_NONE if nothing changed,
+ *         LIB_U8G2_EPD_BUSY if previous refresh is running.
+ */
+lib_u8g2_epd_refresh_t
+lib_u8g2_EpdUpdate(u8g2_t *u8g2, lib_u8g2_epd_t *p_epd);
+
+/**
+ * @brief Check running refresh, call periodically from epoll loop.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param p_epd Refresh manager.
+ *
+ * @return Type of refresh completed since previous call,
+ *         LIB_U8G2_EPD_BUSY if still running, LIB_U8G2_EPD_NONE if idle.
+ */
+lib_u8g2_epd_refresh_t
+lib_u8g2_EpdPoll(u8g2_t *u8g2, lib_u8g2_epd_t *p_epd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_EPD_H
+
+/* [] END OF FILE */
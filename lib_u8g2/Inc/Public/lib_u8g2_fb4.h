@@ -0,0 +1,176 @@
+/***************************************************************************//**
+* @file    lib_u8g2_fb4.h
+* @version 1.0.0
+*
+* @brief 4 bit grayscale frame buffer for SSD1322 and SSD1327 displays.
+*
+* u8g2 frame buffers hold 1 bit pixels only. This module keeps a separate
+* frame buffer with 16 gray levels, two pixels per byte with the left pixel
+* in the upper nibble, rows stored top to bottom. Drawing kernels work on
+* whole bytes where possible: spans and boxes are filled by memset() with
+* doubled level, blits at even columns copy whole rows.
+*
+* Text is drawn with u8g2 fonts set by lib_u8g2_SetFont(). Glyphs are
+* rendered at twice the wanted size and each 2x2 block of font pixels gives
+* one anti-aliased pixel blended over the background, so a font with twice
+* the wanted height has to be selected.
+*
+* Drawing records a dirty rectangle, lib_u8g2_Fb4Send() sets controller
+* column and row address window to it and streams only its rows. u8g2 is
+* used as transport only, set it up by u8g2_Setup_ssd1322_...() or
+* u8g2_Setup_ssd1327_...() and u8g2_InitDisplay() as usual, its frame
+* buffer can be the smallest page buffer.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_FB4_H
+#define LIB_U8G2_FB4_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Maximum glyph bitmap size of fonts used by lib_u8g2_Fb4DrawUTF8(), glyph
+ * coverage buffer takes (size / 2 + 1)^2 bytes of static memory. Larger
+ * glyphs are clipped.
+ */
+#ifndef LIB_U8G2_FB4_GLYPH_MAX
+#define LIB_U8G2_FB4_GLYPH_MAX              (64u)
+#endif
+
+/**
+ * Size of frame buffer in bytes, width must be a multiple of 4.
+ */
+#define LIB_U8G2_FB4_BUF_SIZE(w, h)         ((w) / 2 * (h))
+
+/**
+ * @brief Gray levels.
+ */
+#define LIB_U8G2_FB4_BLACK                  (0u)
+#define LIB_U8G2_FB4_WHITE                  (15u)
+
+/**
+ * @brief Supported display controllers.
+ */
+typedef enum
+{
+    LIB_U8G2_FB4_SSD1322,   // Column address unit is 4 pixels
+    LIB_U8G2_FB4_SSD1327    // Column address unit is 2 pixels
+} lib_u8g2_fb4_ctrl_t;
+
+/**
+ * @brief Frame buffer, fields are private to the module.
+ */
+typedef struct
+{
+    uint8_t *p_buf;
+    uint16_t w;
+    uint16_t h;
+    uint16_t stride;        // Bytes per row
+    lib_u8g2_fb4_ctrl_t ctrl;
+    int16_t dirty_x0;       // Dirty rectangle, empty if x0 >= x1
+    int16_t dirty_y0;
+    int16_t dirty_x1;
+    int16_t dirty_y1;
+} lib_u8g2_fb4_t;
+
+/**
+ * @brief Initialize frame buffer, whole display is marked dirty.
+ *
+ * @param p_fb Frame buffer.
+ * @param p_buf Buffer of LIB_U8G2_FB4_BUF_SIZE() bytes.
+ * @param w Display width, multiple of 4.
+ * @param h Display height.
+ * @param ctrl Display controller.
+ */
+void
+lib_u8g2_Fb4Init(lib_u8g2_fb4_t *p_fb, uint8_t *p_buf, uint16_t w,
+    uint16_t h, lib_u8g2_fb4_ctrl_t ctrl);
+
+/**
+ * @brief Fill whole frame buffer with gray level.
+ */
+void
+lib_u8g2_Fb4Clear(lib_u8g2_fb4_t *p_fb, uint8_t level);
+
+/**
+ * @brief Set single pixel.
+ */
+void
+lib_u8g2_Fb4DrawPixel(lib_u8g2_fb4_t *p_fb, int16_t x, int16_t y,
+    uint8_t level);
+
+/**
+ * @brief Draw horizontal span of w pixels.
+ */
+void
+lib_u8g2_Fb4DrawHSpan(lib_u8g2_fb4_t *p_fb, int16_t x, int16_t y,
+    int16_t w, uint8_t level);
+
+/**
+ * @brief Draw vertical span of h pixels.
+ */
+void
+lib_u8g2_Fb4DrawVSpan(lib_u8g2_fb4_t *p_fb, int16_t x, int16_t y,
+    int16_t h, uint8_t level);
+
+/**
+ * @brief Draw filled box.
+ */
+void
+lib_u8g2_Fb4DrawBox(lib_u8g2_fb4_t *p_fb, int16_t x, int16_t y, int16_t w,
+    int16_t h, uint8_t level);
+
+/**
+ * @brief Copy 4 bit image into frame buffer.
+ *
+ * @param p_fb Frame buffer.
+ * @param x Left column.
+ * @param y Top row.
+ * @param w Image width.
+ * @param h Image height.
+ * @param p_image Image in frame buffer format, rows of (w + 1) / 2 bytes.
+ */
+void
+lib_u8g2_Fb4Blit(lib_u8g2_fb4_t *p_fb, int16_t x, int16_t y, uint16_t w,
+    uint16_t h, const uint8_t *p_image);
+
+/**
+ * @brief Draw anti-aliased UTF-8 string using current u8g2 font.
+ *
+ * @param p_fb Frame buffer.
+ * @param u8g2 u8g2 display descriptor with font of twice the text size.
+ * @param x Left column of text origin.
+ * @param y Baseline row, or row given by u8g2 font position setting.
+ * @param s String.
+ * @param level Text gray level.
+ *
+ * @return String width.
+ */
+int16_t
+lib_u8g2_Fb4DrawUTF8(lib_u8g2_fb4_t *p_fb, u8g2_t *u8g2, int16_t x,
+    int16_t y, const char *s, uint8_t level);
+
+/**
+ * @brief Send dirty rectangle to display and clear it.
+ *
+ * @param p_fb Frame buffer.
+ * @param u8g2 u8g2 display descriptor used as transport.
+ *
+ * @return 1 if anything was sent, 0 otherwise.
+ */
+uint8_t
+lib_u8g2_Fb4Send(lib_u8g2_fb4_t *p_fb, u8g2_t *u8g2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_FB4_H
+
+/* [] END OF FILE */
@@ -0,0 +1,146 @@
+/***************************************************************************//**
+* @file    lib_u8g2_font.h
+* @version 1.0.0
+*
+* @brief Indexed glyph lookup and drawing for large Unicode u8g2 fonts.
+*
+* u8g2 locates a Unicode glyph by walking the font glyph records one by one.
+* For big fonts with sparse code points (symbols, CJK) this walk dominates
+* text rendering time. Functions in this module build a sorted encoding index
+* once per font in lib_u8g2_SetFont() and use binary search afterwards.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_FONT_H
+#define LIB_U8G2_FONT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Number of fonts which can be indexed at the same time.
+ */
+#ifndef LIB_U8G2_GLYPH_INDEX_FONTS
+#define LIB_U8G2_GLYPH_INDEX_FONTS          (4u)
+#endif
+
+/**
+ * Size of the static glyph index arena in bytes. Each indexed Unicode glyph
+ * takes 6 bytes. Define LIB_U8G2_GLYPH_INDEX_USE_HEAP to allocate indexes
+ * with malloc() instead.
+ */
+#ifndef LIB_U8G2_GLYPH_INDEX_ARENA_SIZE
+#define LIB_U8G2_GLYPH_INDEX_ARENA_SIZE     (8192u)
+#endif
+
+/**
+ * @brief Glyph bitmap placement.
+ */
+typedef struct
+{
+    uint8_t width;          // Bitmap size
+    uint8_t height;
+    int8_t x;               // Bitmap left column relative to origin
+    int8_t y;               // Bitmap top row relative to baseline
+    int8_t delta;           // Advance to next glyph origin
+} lib_u8g2_glyph_info_t;
+
+/**
+ * @brief Receives run of len foreground pixels at glyph bitmap position.
+ */
+typedef void (*lib_u8g2_glyph_run_cb)(void *p_ctx, uint8_t x, uint8_t y,
+    uint8_t len);
+
+/**
+ * @brief Set font and build its Unicode glyph index.
+ *
+ * Replacement for u8g2_SetFont(). The index is built only the first time
+ * a font is selected, fonts without Unicode glyphs are not indexed. If the
+ * index does not fit in the arena the font falls back to u8g2 lookup.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param font u8g2 font.
+ */
+void
+lib_u8g2_SetFont(u8g2_t *u8g2, const uint8_t *font);
+
+/**
+ * @brief Get glyph bitmap data of current font.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param encoding Glyph encoding.
+ *
+ * @return Pointer to glyph data or NULL if glyph is not present in font.
+ */
+const uint8_t *
+lib_u8g2_GetGlyphData(u8g2_t *u8g2, uint16_t encoding);
+
+/**
+ * @brief Draw single glyph using indexed lookup.
+ *
+ * Drop-in replacement for u8g2_DrawGlyph().
+ *
+ * @return Glyph x advance.
+ */
+u8g2_uint_t
+lib_u8g2_DrawGlyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    uint16_t encoding);
+
+/**
+ * @brief Draw UTF-8 string using indexed lookup.
+ *
+ * Drop-in replacement for u8g2_DrawUTF8() without kerning support.
+ *
+ * @return String width.
+ */
+u8g2_uint_t
+lib_u8g2_DrawUTF8(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const char *s);
+
+/**
+ * @brief Decode next code point of UTF-8 string.
+ *
+ * Sequences of up to 3 bytes are supported, invalid bytes are skipped.
+ *
+ * @param p_s String pointer, advanced past decoded sequence.
+ *
+ * @return Code point, 0 at end of string.
+ */
+uint16_t
+lib_u8g2_NextUTF8(const char **p_s);
+
+/**
+ * @brief Decode glyph bitmap of current font into foreground pixel runs.
+ *
+ * Lets modules render glyphs to targets other than u8g2 frame buffer.
+ * Runs are reported top to bottom, each run lies within one bitmap row.
+ *
+ * @param u8g2 u8g2 display descriptor with font set.
+ * @param glyph_data Glyph data from lib_u8g2_GetGlyphData().
+ * @param p_info Glyph placement, filled before first run is reported.
+ * @param run_cb Run callback, NULL to get placement only.
+ * @param p_ctx Callback context.
+ */
+void
+lib_u8g2_DecodeGlyph(u8g2_t *u8g2, const uint8_t *glyph_data,
+    lib_u8g2_glyph_info_t *p_info, lib_u8g2_glyph_run_cb run_cb, void *p_ctx);
+
+/**
+ * @brief Drop all glyph indexes.
+ *
+ * Must be called if font data referenced by an index is released.
+ */
+void
+lib_u8g2_ResetGlyphIndex(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_FONT_H
+
+/* [] END OF FILE */
@@ -0,0 +1,172 @@
+/***************************************************************************//**
+* @file    lib_u8g2_gauge.h
+* @version 1.0.0
+*
+* @brief Dial gauges, arc meters and bar graphs with partial redraw.
+*
+* Gauges remember shown needle, arc or bar position. Setting a value draws
+* only the swept part: dial erases old needle and draws new one, arc meter
+* and bar graph fill or erase only the part between old and new position.
+* With dirty area tracking (lib_u8g2_dirty.h) only that part is sent.
+*
+* Angles are in 1/1024 turn units, 0 points up and angles grow clockwise.
+* Needle and arc geometry uses quarter wave sine table in Q14 fixed point,
+* no floating point is used.
+*
+* Gauges are drawn in color 1 on cleared background, u8g2 draw color is
+* restored on return.
+*
+* Requires full frame buffer, gauge area must lie within display.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_GAUGE_H
+#define LIB_U8G2_GAUGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Angle units per turn.
+ */
+#define LIB_U8G2_ANGLE_TURN                 (1024u)
+
+/**
+ * Fixed point one of lib_u8g2_Sin() and lib_u8g2_Cos() results.
+ */
+#define LIB_U8G2_TRIG_ONE                   (16384)
+
+/**
+ * Number of dial scale divisions.
+ */
+#ifndef LIB_U8G2_GAUGE_DIVISIONS
+#define LIB_U8G2_GAUGE_DIVISIONS            (10u)
+#endif
+
+/**
+ * @brief Gauge types.
+ */
+typedef enum
+{
+    LIB_U8G2_GAUGE_DIAL,
+    LIB_U8G2_GAUGE_ARC,
+    LIB_U8G2_GAUGE_HBAR,    // Grows to the right
+    LIB_U8G2_GAUGE_VBAR     // Grows upwards
+} lib_u8g2_gauge_type_t;
+
+/**
+ * @brief Gauge, fields are private to the module.
+ */
+typedef struct
+{
+    lib_u8g2_gauge_type_t type;
+    int16_t x;              // Dial and arc center, bar top left corner
+    int16_t y;
+    int16_t w;              // Bar size
+    int16_t h;
+    int16_t r_in;           // Arc inner radius
+    int16_t r_out;          // Dial and arc outer radius
+    uint16_t start;         // Angle of minimum value
+    uint16_t sweep;         // Angle from minimum to maximum value
+    uint16_t step;          // Angle between arc fill lines
+    int16_t min;
+    int16_t max;
+    int16_t shown;          // Needle angle, arc lines or bar length shown
+} lib_u8g2_gauge_t;
+
+/**
+ * @brief Get sine of angle.
+ *
+ * @param angle Angle in LIB_U8G2_ANGLE_TURN units per turn.
+ *
+ * @return Sine multiplied by LIB_U8G2_TRIG_ONE.
+ */
+int16_t
+lib_u8g2_Sin(uint16_t angle);
+
+/**
+ * @brief Get cosine of angle, see lib_u8g2_Sin().
+ */
+int16_t
+lib_u8g2_Cos(uint16_t angle);
+
+/**
+ * @brief Initialize dial gauge with needle.
+ *
+ * @param p_gauge Gauge.
+ * @param cx Center column.
+ * @param cy Center row.
+ * @param r Radius of scale ticks.
+ * @param start Angle of minimum value.
+ * @param sweep Angle from minimum to maximum value, clockwise.
+ * @param min Minimum value.
+ * @param max Maximum value.
+ */
+void
+lib_u8g2_GaugeInitDial(lib_u8g2_gauge_t *p_gauge, int16_t cx, int16_t cy,
+    int16_t r, uint16_t start, uint16_t sweep, int16_t min, int16_t max);
+
+/**
+ * @brief Initialize arc meter filled between inner and outer radius.
+ *
+ * @param r_in Inner radius, at least 1.
+ * @param r_out Outer radius.
+ *
+ * Other parameters are the same as of lib_u8g2_GaugeInitDial().
+ */
+void
+lib_u8g2_GaugeInitArc(lib_u8g2_gauge_t *p_gauge, int16_t cx, int16_t cy,
+    int16_t r_in, int16_t r_out, uint16_t start, uint16_t sweep, int16_t min,
+    int16_t max);
+
+/**
+ * @brief Initialize bar graph with one pixel frame.
+ *
+ * @param p_gauge Gauge.
+ * @param x Left column.
+ * @param y Top row.
+ * @param w Width including frame.
+ * @param h Height including frame.
+ * @param is_vertical 1 for bar growing upwards, 0 for bar growing right.
+ * @param min Minimum value.
+ * @param max Maximum value.
+ */
+void
+lib_u8g2_GaugeInitBar(lib_u8g2_gauge_t *p_gauge, int16_t x, int16_t y,
+    int16_t w, int16_t h, uint8_t is_vertical, int16_t min, int16_t max);
+
+/**
+ * @brief Clear gauge area and draw whole gauge with shown value.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param p_gauge Gauge.
+ *
+ * @return 1 on success, 0 if frame buffer is not supported.
+ */
+uint8_t
+lib_u8g2_GaugeDraw(u8g2_t *u8g2, lib_u8g2_gauge_t *p_gauge);
+
+/**
+ * @brief Set value, only swept part of gauge is redrawn.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param p_gauge Gauge drawn by lib_u8g2_GaugeDraw().
+ * @param value New value, clamped to gauge range.
+ *
+ * @return 1 on success, 0 if frame buffer is not supported.
+ */
+uint8_t
+lib_u8g2_GaugeSet(u8g2_t *u8g2, lib_u8g2_gauge_t *p_gauge, int16_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_GAUGE_H
+
+/* [] END OF FILE */
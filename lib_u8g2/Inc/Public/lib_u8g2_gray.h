@@ -0,0 +1,132 @@
+/***************************************************************************//**
+* @file    lib_u8g2_gray.h
+* @version 1.0.0
+*
+* @brief Grayscale images on SSD1306 by frame rate modulation.
+*
+* Image is split into binary weighted bit planes. Plane k is shown in 2^k
+* frames of each cycle of 2^bits - 1 frames, perceived brightness of a
+* pixel is then proportional to its level. Each frame sends only columns
+* of pages where the next plane differs from the shown one. On displays
+* with at most 32 rows, 2 bit images keep both planes in display RAM and
+* each frame is a single start line command.
+*
+* Frames are advanced by lib_u8g2_GrayStep() at 60 Hz or more, e.g. from a
+* timerfd handler. lib_u8g2_GrayBenchmark() measures achievable frame
+* rate of the transport.
+*
+* Planes are stored page-major like SSD1306 display RAM, each plane holds
+* whole display. Frame buffer is not used, restore display content by
+* u8g2_SendBuffer() after lib_u8g2_GrayStop().
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_GRAY_H
+#define LIB_U8G2_GRAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Maximum supported bits per pixel.
+ */
+#define LIB_U8G2_GRAY_MAX_BITS              (3u)
+
+/**
+ * @brief Transfer statistics.
+ */
+typedef struct
+{
+    uint32_t frames;        // Frames shown
+    uint32_t bytes;         // Display data bytes sent
+    uint32_t elapsed_us;    // Measured time, set by benchmark only
+} lib_u8g2_gray_stats_t;
+
+/**
+ * @brief Grayscale image state, fields are private to the module.
+ */
+typedef struct
+{
+    const uint8_t *p_planes;
+    uint16_t plane_size;
+    uint8_t bits;
+    uint8_t frame;          // Frame within cycle
+    uint8_t plane;          // Shown plane
+    uint8_t is_start_line;  // Planes are kept in display RAM
+    lib_u8g2_gray_stats_t stats;
+} lib_u8g2_gray_t;
+
+/**
+ * @brief Get size of planes buffer for display and bits per pixel.
+ */
+uint16_t
+lib_u8g2_GrayPlanesSize(u8g2_t *u8g2, uint8_t bits);
+
+/**
+ * @brief Convert row-major pixel levels to bit planes.
+ *
+ * @param u8g2 u8g2 display descriptor, gives plane size.
+ * @param p_planes Buffer of lib_u8g2_GrayPlanesSize() bytes.
+ * @param p_levels Pixel levels 0 to 2^bits - 1, one byte per pixel.
+ * @param w Image width, at most display width.
+ * @param h Image height, at most display height.
+ * @param bits Bits per pixel.
+ */
+void
+lib_u8g2_GrayPlanesFromLevels(u8g2_t *u8g2, uint8_t *p_planes,
+    const uint8_t *p_levels, uint16_t w, uint16_t h, uint8_t bits);
+
+/**
+ * @brief Start showing grayscale image.
+ *
+ * Sends first plane, display start line is reset.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param p_gray Image state.
+ * @param p_planes Bit planes, least significant plane first.
+ * @param bits Bits per pixel, 1 to LIB_U8G2_GRAY_MAX_BITS.
+ *
+ * @return 1 on success, 0 if bits are not supported.
+ */
+uint8_t
+lib_u8g2_GrayStart(u8g2_t *u8g2, lib_u8g2_gray_t *p_gray,
+    const uint8_t *p_planes, uint8_t bits);
+
+/**
+ * @brief Show next frame.
+ */
+void
+lib_u8g2_GrayStep(u8g2_t *u8g2, lib_u8g2_gray_t *p_gray);
+
+/**
+ * @brief Stop showing image, display start line is reset.
+ */
+void
+lib_u8g2_GrayStop(u8g2_t *u8g2, lib_u8g2_gray_t *p_gray);
+
+/**
+ * @brief Show given number of frames as fast as possible and measure time.
+ *
+ * Frames per second equal frames * 1000000 / elapsed_us.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param p_gray Started image.
+ * @param frames Number of frames.
+ * @param p_stats Statistics of measured frames.
+ */
+void
+lib_u8g2_GrayBenchmark(u8g2_t *u8g2, lib_u8g2_gray_t *p_gray,
+    uint32_t frames, lib_u8g2_gray_stats_t *p_stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_GRAY_H
+
+/* [] END OF FILE */
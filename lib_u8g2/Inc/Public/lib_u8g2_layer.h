@@ -0,0 +1,105 @@
+/***************************************************************************//**
+* @file    lib_u8g2_layer.h
+* @version 1.0.0
+*
+* @brief Layered frame buffer compositing.
+*
+* Application provides frame buffer sized layers and selects the layer
+* drawn to, all u8g2 and lib_u8g2 drawing functions then work on it.
+* lib_u8g2_LayerSend() composites visible layers bottom to top into u8g2
+* frame buffer and sends it. Static content such as frames and labels is
+* drawn once to a background layer, each frame only redraws the overlay.
+*
+* With dirty area tracking active (lib_u8g2_dirty.h) only tiles covering
+* the dirty area are composited and sent, otherwise whole frame buffer.
+* Requires full frame buffer.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_LAYER_H
+#define LIB_U8G2_LAYER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Maximum number of layers.
+ */
+#ifndef LIB_U8G2_LAYER_MAX
+#define LIB_U8G2_LAYER_MAX                  (4u)
+#endif
+
+/**
+ * @brief Returned by lib_u8g2_LayerAdd() if no layer can be added.
+ */
+#define LIB_U8G2_LAYER_NONE                 (0xFFu)
+
+/**
+ * @brief Combination of layer with layers below it, bottom layer is copied.
+ */
+typedef enum
+{
+    LIB_U8G2_BLEND_OR,      // Set pixels are drawn
+    LIB_U8G2_BLEND_AND_NOT, // Set pixels erase layers below
+    LIB_U8G2_BLEND_XOR      // Set pixels invert layers below
+} lib_u8g2_blend_t;
+
+/**
+ * @brief Start layer compositing, removes all layers.
+ *
+ * Call after u8g2_Setup_...(), u8g2 frame buffer becomes composite buffer.
+ * Layers are kept by the module for a single display, init for another
+ * display or with another frame buffer takes its buffer and removes
+ * layers of the previous one.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ */
+void
+lib_u8g2_LayerInit(u8g2_t *u8g2);
+
+/**
+ * @brief Add cleared layer on top of existing layers.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param p_buf Layer buffer of u8g2 frame buffer size.
+ * @param blend Combination with layers below.
+ *
+ * @return Layer index, LIB_U8G2_LAYER_NONE if all layers are used.
+ */
+uint8_t
+lib_u8g2_LayerAdd(u8g2_t *u8g2, uint8_t *p_buf, lib_u8g2_blend_t blend);
+
+/**
+ * @brief Direct drawing to layer.
+ */
+void
+lib_u8g2_LayerSelect(u8g2_t *u8g2, uint8_t layer);
+
+/**
+ * @brief Show or hide layer, whole display is marked dirty.
+ */
+void
+lib_u8g2_LayerSetVisible(u8g2_t *u8g2, uint8_t layer, uint8_t is_visible);
+
+/**
+ * @brief Composite dirty tiles of visible layers and send them to display.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ *
+ * @return 1 if anything was sent, 0 otherwise.
+ */
+uint8_t
+lib_u8g2_LayerSend(u8g2_t *u8g2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_LAYER_H
+
+/* [] END OF FILE */
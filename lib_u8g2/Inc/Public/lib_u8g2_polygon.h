@@ -0,0 +1,98 @@
+/***************************************************************************//**
+* @file    lib_u8g2_polygon.h
+* @version 1.0.0
+*
+* @brief Scanline polygon filler with active edge table.
+*
+* Polygons are scanned column by column so each filled run is a vertical
+* span, which sets whole bytes of vertical byte (SSD1306) buffers. Edge
+* intersections are stepped in 16.16 fixed point. A pixel is filled if its
+* center lies inside the polygon (non-zero winding rule). All polygons of a
+* batch are filled as their union, polygons outside of current page are
+* skipped, so page buffer modes do not pay for invisible polygons. Union of
+* overlapping self-intersecting polygons may leave holes.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_POLYGON_H
+#define LIB_U8G2_POLYGON_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Maximum number of polygon edges rasterised together. Bigger batches are
+ * split, single polygons with more edges are not drawn.
+ */
+#ifndef LIB_U8G2_POLYGON_MAX_EDGES
+#define LIB_U8G2_POLYGON_MAX_EDGES          (64u)
+#endif
+
+/**
+ * @brief Polygon given by vertex list, last vertex connects to the first.
+ */
+typedef struct
+{
+    const lib_u8g2_point_t *points;
+    uint8_t count;
+} lib_u8g2_polygon_t;
+
+/**
+ * @brief Fill batch of polygons with current draw color.
+ *
+ * Polygon may have at most LIB_U8G2_POLYGON_MAX_EDGES vertices, polygons
+ * with more vertices are skipped, the rest of the batch is drawn.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param polygons Array of polygons.
+ * @param count Number of polygons.
+ *
+ * @return 1 on success, 0 if a polygon had too many vertices.
+ */
+uint8_t
+lib_u8g2_FillPolygons(u8g2_t *u8g2, const lib_u8g2_polygon_t *polygons,
+    uint8_t count);
+
+/**
+ * @brief Fill single polygon with current draw color.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param points Array of polygon vertices.
+ * @param count Number of vertices, at most LIB_U8G2_POLYGON_MAX_EDGES.
+ *
+ * @return 1 on success, 0 if polygon has too many vertices and is not
+ * drawn.
+ */
+uint8_t
+lib_u8g2_FillPolygon(u8g2_t *u8g2, const lib_u8g2_point_t *points,
+    uint8_t count);
+
+/**
+ * @brief Measure rotating needle workload drawn by u8g2 and by this module.
+ *
+ * Each frame clears frame buffer and draws eight kite shaped gauge needles
+ * rotated by about 3.6 degrees from the previous frame. First run draws
+ * them one by one by u8g2_DrawPolygon(), second run as one batch by
+ * lib_u8g2_FillPolygons(). Frame buffer is cleared afterwards. In page
+ * buffer mode only the current page is drawn.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param frames Number of frames of each run.
+ * @param p_result Time of both runs.
+ */
+void
+lib_u8g2_PolygonBenchmark(u8g2_t *u8g2, uint32_t frames,
+    lib_u8g2_bench_t *p_result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_POLYGON_H
+
+/* [] END OF FILE */
@@ -0,0 +1,119 @@
+/***************************************************************************//**
+* @file    lib_u8g2_region.h
+* @version 1.0.0
+*
+* @brief Copying and scrolling of frame buffer regions.
+*
+* Rectangles are moved inside u8g2 tile buffer without redrawing their
+* content. Moves keeping row position within page are done by memmove(),
+* other vertical moves shift bits across pages. Source and destination
+* may overlap.
+*
+* Tiles under popups and overlays are saved to a fixed size stack by
+* lib_u8g2_PushRegion() and put back by lib_u8g2_PopRegion(), closing
+* a popup then costs a tile copy instead of redrawing the screen below.
+*
+* Coordinates are display coordinates, only rows held by buffer (current
+* page in page buffer mode) are processed. Supported are vertical byte
+* (SSD1306) buffers with U8G2_R0 rotation.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_REGION_H
+#define LIB_U8G2_REGION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Size of region stack in bytes, saved region takes 8 bytes per tile and
+ * 4 bytes of header.
+ */
+#ifndef LIB_U8G2_REGION_STACK_SIZE
+#define LIB_U8G2_REGION_STACK_SIZE          (512u)
+#endif
+
+/**
+ * @brief Copy rectangle of w x h pixels from src_x, src_y to dst_x, dst_y.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ *
+ * @return 1 on success, 0 if buffer layout is not supported.
+ */
+uint8_t
+lib_u8g2_CopyRegion(u8g2_t *u8g2, int16_t src_x, int16_t src_y, int16_t w,
+    int16_t h, int16_t dst_x, int16_t dst_y);
+
+/**
+ * @brief Scroll content of rectangle by dx, dy pixels.
+ *
+ * Content moved out of rectangle is lost, exposed part of rectangle is
+ * cleared and can be drawn by application. Rectangle is clipped to frame
+ * buffer, content outside of it is not scrolled in.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param x Rectangle left column.
+ * @param y Rectangle top row.
+ * @param w Rectangle width.
+ * @param h Rectangle height.
+ * @param dx Horizontal shift, positive values move content right.
+ * @param dy Vertical shift, positive values move content down.
+ *
+ * @return 1 on success, 0 if buffer layout is not supported.
+ */
+uint8_t
+lib_u8g2_ScrollRegion(u8g2_t *u8g2, int16_t x, int16_t y, int16_t w,
+    int16_t h, int16_t dx, int16_t dy);
+
+/**
+ * @brief Clear rectangle of w x h pixels regardless of draw color.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ *
+ * @return 1 on success, 0 if buffer layout is not supported.
+ */
+uint8_t
+lib_u8g2_ClearRegion(u8g2_t *u8g2, int16_t x, int16_t y, int16_t w,
+    int16_t h);
+
+/**
+ * @brief Save tiles covering rectangle to region stack.
+ *
+ * Requires full frame buffer.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param x Rectangle left column.
+ * @param y Rectangle top row.
+ * @param w Rectangle width.
+ * @param h Rectangle height.
+ *
+ * @return 1 on success, 0 if stack is full or buffer is not supported.
+ */
+uint8_t
+lib_u8g2_PushRegion(u8g2_t *u8g2, int16_t x, int16_t y, int16_t w,
+    int16_t h);
+
+/**
+ * @brief Restore tiles saved by the last lib_u8g2_PushRegion() call.
+ *
+ * Restored tiles are marked dirty.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ *
+ * @return 1 on success, 0 if stack is empty.
+ */
+uint8_t
+lib_u8g2_PopRegion(u8g2_t *u8g2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_REGION_H
+
+/* [] END OF FILE */
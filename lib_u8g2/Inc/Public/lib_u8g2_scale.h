@@ -0,0 +1,83 @@
+/***************************************************************************//**
+* @file    lib_u8g2_scale.h
+* @version 1.0.0
+*
+* @brief Bitmaps and glyphs drawn at integer scale.
+*
+* Large readouts are drawn from small fonts and icons magnified 2x, 3x or
+* 4x instead of storing and decoding big fonts. Each source pixel column
+* is spread vertically by a lookup table expanding 4 bits to 4 * scale
+* bits, result is written to scale frame buffer columns as whole page
+* bytes without per pixel drawing.
+*
+* Set pixels are drawn in u8g2 draw color, unset pixels are transparent.
+* Glyphs use current font set by lib_u8g2_SetFont() and its reference
+* position. Drawing ignores u8g2 clip window. Requires full frame buffer
+* with vertical byte layout and U8G2_R0 rotation.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_SCALE_H
+#define LIB_U8G2_SCALE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Maximum source height of bitmaps and glyphs and maximum source width of
+ * glyphs, larger sources are clipped.
+ */
+#define LIB_U8G2_SCALE_MAX_SIZE             (32u)
+
+/**
+ * Maximum scale.
+ */
+#define LIB_U8G2_SCALE_MAX                  (4u)
+
+/**
+ * @brief Draw XBM bitmap magnified by scale.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param x Left column.
+ * @param y Top row.
+ * @param w Bitmap width.
+ * @param h Bitmap height.
+ * @param scale Scale 1 to LIB_U8G2_SCALE_MAX.
+ * @param xbm XBM bitmap.
+ *
+ * @return 1 on success, 0 if frame buffer or scale is not supported.
+ */
+uint8_t
+lib_u8g2_DrawScaledXBM(u8g2_t *u8g2, int16_t x, int16_t y, uint8_t w,
+    uint8_t h, uint8_t scale, const uint8_t *xbm);
+
+/**
+ * @brief Draw glyph of current font magnified by scale.
+ *
+ * @return Glyph x advance at scale, 0 if glyph is not drawn.
+ */
+int16_t
+lib_u8g2_DrawScaledGlyph(u8g2_t *u8g2, int16_t x, int16_t y, uint8_t scale,
+    uint16_t encoding);
+
+/**
+ * @brief Draw UTF-8 string of current font magnified by scale.
+ *
+ * @return String width.
+ */
+int16_t
+lib_u8g2_DrawScaledUTF8(u8g2_t *u8g2, int16_t x, int16_t y, uint8_t scale,
+    const char *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_SCALE_H
+
+/* [] END OF FILE */
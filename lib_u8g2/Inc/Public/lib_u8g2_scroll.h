@@ -0,0 +1,153 @@
+/***************************************************************************//**
+* @file    lib_u8g2_scroll.h
+* @version 1.0.0
+*
+* @brief Hardware assisted scrolling for SSD1306 displays.
+*
+* Vertical scrolling moves SSD1306 display start line. Horizontal scrolling
+* resends the scrolled band, or uses one column content scroll commands
+* (2Ch/2Dh) if enabled by LIB_U8G2_SCROLL_MAX_HW_STEPS. Software frame buffer
+* is shifted together with display RAM so it always holds visible picture.
+* Newly exposed rows or columns are cleared in frame buffer and sent to
+* display by lib_u8g2_SendScrolled() after application draws new content.
+*
+* Requires full frame buffer (u8g2_Setup_..._f() functions) with vertical
+* byte layout and U8G2_R0 rotation. While display start line is not zero,
+* display RAM pages do not match frame buffer pages, use
+* lib_u8g2_ScrollSendArea() or lib_u8g2_ScrollReset() instead of
+* u8g2_SendBuffer().
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_SCROLL_H
+#define LIB_U8G2_SCROLL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Maximum number of columns scrolled by display content scroll commands
+ * in one lib_u8g2_ScrollHorizontal() call. Longer moves resend whole band.
+ *
+ * One column content scroll (2Ch/2Dh) is supported by SSD1306B and SSD1309
+ * controllers only. Original SSD1306 parses its arguments as commands and
+ * corrupts the display, so content scroll is disabled by default.
+ */
+#ifndef LIB_U8G2_SCROLL_MAX_HW_STEPS
+#define LIB_U8G2_SCROLL_MAX_HW_STEPS        (0u)
+#endif
+
+/**
+ * Delay between consecutive content scroll commands in milliseconds,
+ * SSD1306 requires at least two frame periods.
+ */
+#ifndef LIB_U8G2_SCROLL_STEP_DELAY_MS
+#define LIB_U8G2_SCROLL_STEP_DELAY_MS       (20u)
+#endif
+
+/**
+ * @brief Reset display start line to zero and send whole frame buffer.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ */
+void
+lib_u8g2_ScrollReset(u8g2_t *u8g2);
+
+/**
+ * @brief Scroll whole display vertically.
+ *
+ * Display start line is updated immediately. Exposed rows are cleared in
+ * frame buffer and show stale content until lib_u8g2_SendScrolled().
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param rows Number of rows, positive values move content up.
+ *
+ * @return 1 on success, 0 if frame buffer is not supported.
+ */
+uint8_t
+lib_u8g2_ScrollVertical(u8g2_t *u8g2, int16_t rows);
+
+/**
+ * @brief Scroll band of pages horizontally.
+ *
+ * With content scroll enabled, display content is moved immediately and
+ * exposed columns show stale content until lib_u8g2_SendScrolled().
+ * Otherwise the whole band is sent by lib_u8g2_SendScrolled(). Exposed
+ * columns are cleared in frame buffer.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param cols Number of columns, positive values move content left.
+ * @param page_first First page (8 rows) of scrolled band.
+ * @param page_last Last page of scrolled band.
+ *
+ * @return 1 on success, 0 if frame buffer is not supported.
+ */
+uint8_t
+lib_u8g2_ScrollHorizontal(u8g2_t *u8g2, int16_t cols, uint8_t page_first,
+    uint8_t page_last);
+
+/**
+ * @brief Scroll window of columns x0 <= x < x1 within band of pages.
+ *
+ * Same as lib_u8g2_ScrollHorizontal(), content scroll is limited to given
+ * columns, e.g. a chart or ticker.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param cols Number of columns, positive values move content left.
+ * @param x0 First column of window.
+ * @param x1 Column after last column of window.
+ * @param page_first First page (8 rows) of scrolled band.
+ * @param page_last Last page of scrolled band.
+ *
+ * @return 1 on success, 0 if frame buffer or window is not supported.
+ */
+uint8_t
+lib_u8g2_ScrollWindow(u8g2_t *u8g2, int16_t cols, int16_t x0, int16_t x1,
+    uint8_t page_first, uint8_t page_last);
+
+/**
+ * @brief Send frame buffer content of areas exposed by scrolling.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ */
+void
+lib_u8g2_SendScrolled(u8g2_t *u8g2);
+
+/**
+ * @brief Send frame buffer area x0 <= x < x1, y0 <= y < y1 to display.
+ *
+ * Rows are mapped to display RAM using current display start line. Whole
+ * display RAM pages covering the area are sent.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ */
+void
+lib_u8g2_ScrollSendArea(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1,
+    int16_t y1);
+
+/**
+ * @brief Get current display start line.
+ */
+uint8_t
+lib_u8g2_GetStartLine(void);
+
+/**
+ * @brief Set display start line used for mapping frame buffer rows.
+ *
+ * No command is sent, intended for modules moving start line themselves.
+ */
+void
+lib_u8g2_SetStartLine(uint8_t line);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_SCROLL_H
+
+/* [] END OF FILE */
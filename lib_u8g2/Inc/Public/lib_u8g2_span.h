@@ -0,0 +1,168 @@
+/***************************************************************************//**
+* @file    lib_u8g2_span.h
+* @version 1.0.0
+*
+* @brief Word-wide span fill kernels for vertical byte (SSD1306) buffers.
+*
+* u8g2 sets buffer pixels one byte per column, one bit at a time. Functions
+* in this module fill whole bytes across pages for vertical spans and apply
+* a single page mask to contiguous bytes using 32/64-bit words (or NEON when
+* available) for horizontal spans.
+*
+* Fast paths are used for U8G2_R0 rotation and u8g2 buffers using
+* u8g2_ll_hvline_vertical_top_lsb layout (SSD1306, SH1106 and similar),
+* other configurations fall back to u8g2 drawing functions.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_SPAN_H
+#define LIB_U8G2_SPAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * @brief Span drawing context.
+ *
+ * Holds visible area and draw color evaluated once for a batch of spans.
+ * Context is valid until draw color, clip window or current page changes.
+ */
+typedef struct
+{
+    u8g2_t *u8g2;
+    int16_t x0;             // Visible area, half-open ranges
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+    uint8_t color;          // u8g2 draw color
+    uint8_t is_direct;      // Buffer is written directly by span kernels
+} lib_u8g2_span_t;
+
+/**
+ * @brief Replace u8g2 low level line drawing with span kernels.
+ *
+ * All u8g2 drawing functions (boxes, frames, circles, text...) then use
+ * the word-wide kernels. Call after u8g2_Setup_...() function. Buffers
+ * with layout other than vertical top LSB are left untouched.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ */
+void
+lib_u8g2_SetSpanBackend(u8g2_t *u8g2);
+
+/**
+ * @brief Low level line callback for vertical top LSB buffers.
+ *
+ * Replacement for u8g2_ll_hvline_vertical_top_lsb(). Coordinates are
+ * already clipped and relative to current buffer page.
+ */
+void
+lib_u8g2_ll_hvline(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    u8g2_uint_t len, uint8_t dir);
+
+/**
+ * @brief Check if span kernels can write directly to u8g2 buffer.
+ *
+ * @return 1 if buffer layout and rotation are supported, 0 otherwise.
+ */
+uint8_t
+lib_u8g2_IsSpanBuffer(u8g2_t *u8g2);
+
+/**
+ * @brief Set up span context for current u8g2 state.
+ *
+ * @param p_span Span context to initialize.
+ * @param u8g2 u8g2 display descriptor.
+ */
+void
+lib_u8g2_SpanBegin(lib_u8g2_span_t *p_span, u8g2_t *u8g2);
+
+/**
+ * @brief Fill area x0 <= x < x1, y0 <= y < y1 using span context.
+ *
+ * Area is clipped to visible area of the context.
+ */
+void
+lib_u8g2_SpanFill(const lib_u8g2_span_t *p_span, int16_t x0, int16_t y0,
+    int16_t x1, int16_t y1);
+
+/**
+ * @brief Set single pixel using span context.
+ */
+void
+lib_u8g2_SpanPixel(const lib_u8g2_span_t *p_span, int16_t x, int16_t y);
+
+/**
+ * @brief Fill area with current draw color.
+ *
+ * Area is given by half-open ranges x0 <= x < x1 and y0 <= y < y1 and
+ * is clipped to display, current page and clip window. Negative and
+ * out of display coordinates are allowed.
+ */
+void
+lib_u8g2_FillArea(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1,
+    int16_t y1);
+
+/**
+ * @brief Draw horizontal span of len pixels starting at x, y.
+ */
+void
+lib_u8g2_DrawHSpan(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    u8g2_uint_t len);
+
+/**
+ * @brief Draw vertical span of len pixels starting at x, y.
+ */
+void
+lib_u8g2_DrawVSpan(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    u8g2_uint_t len);
+
+/**
+ * @brief Draw filled box, replacement for u8g2_DrawBox().
+ */
+void
+lib_u8g2_DrawBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    u8g2_uint_t w, u8g2_uint_t h);
+
+/**
+ * @brief Draw box outline, replacement for u8g2_DrawFrame().
+ *
+ * Each outline pixel is drawn once, frames one pixel wide or high are a
+ * single span.
+ */
+void
+lib_u8g2_DrawFrame(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    u8g2_uint_t w, u8g2_uint_t h);
+
+/**
+ * @brief Measure typical box and text workload drawn by u8g2 and by span
+ *        kernels.
+ *
+ * Workload of frame, boxes, lines, disc, XOR box and text of current font
+ * (if set) is drawn iterations times with stock u8g2 line callback and
+ * u8g2_DrawBox()/u8g2_DrawFrame(), then with lib_u8g2_ll_hvline() and
+ * lib_u8g2_DrawBox()/lib_u8g2_DrawFrame(). Frame buffer is cleared
+ * afterwards. In page buffer mode only the current page is drawn.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param iterations Number of workload repetitions of each run.
+ * @param p_result Time of both runs.
+ *
+ * @return 1 on success, 0 if buffer layout is not supported.
+ */
+uint8_t
+lib_u8g2_SpanBenchmark(u8g2_t *u8g2, uint32_t iterations,
+    lib_u8g2_bench_t *p_result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_SPAN_H
+
+/* [] END OF FILE */
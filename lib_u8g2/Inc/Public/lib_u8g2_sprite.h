@@ -0,0 +1,121 @@
+/***************************************************************************//**
+* @file    lib_u8g2_sprite.h
+* @version 1.0.0
+*
+* @brief Sprites blitted by whole frame buffer bytes.
+*
+* Sprite frames are converted from XBM once and stored pre-shifted for all
+* 8 row positions within a page, drawing is then a byte copy per column
+* and page without bit shifting. XOR sprites are erased by drawing them
+* again, other sprites save and restore frame buffer bytes below them.
+* Moving a sprite or changing its frame touches only bytes of its old and
+* new position and marks them dirty.
+*
+* Overlapping sprites must be moved in reverse drawing order. Drawing
+* ignores u8g2 clip window. Requires full frame buffer with vertical byte
+* layout and U8G2_R0 rotation.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_SPRITE_H
+#define LIB_U8G2_SPRITE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Size of buffer for sprite of w x h pixels with given number of frames.
+ * Pre-shifted phases of a frame take w * (h + 7) bytes, twice as much with
+ * mask, background save area takes w * ((h + 14) / 8) bytes.
+ */
+#define LIB_U8G2_SPRITE_BUF_SIZE(w, h, frames, has_mask) \
+    ((w) * ((frames) * ((has_mask) ? 2 : 1) * ((h) + 7) + ((h) + 14) / 8))
+
+/**
+ * @brief Sprite drawing modes.
+ */
+typedef enum
+{
+    LIB_U8G2_SPRITE_OR,     // Set pixels are drawn
+    LIB_U8G2_SPRITE_MASKED, // Mask pixels are replaced by sprite pixels
+    LIB_U8G2_SPRITE_XOR     // Set pixels invert background
+} lib_u8g2_sprite_mode_t;
+
+/**
+ * @brief Sprite, fields are private to the module.
+ */
+typedef struct
+{
+    uint8_t *p_buf;
+    uint8_t w;
+    uint8_t h;
+    uint8_t frame_cnt;
+    uint8_t has_mask;
+    lib_u8g2_sprite_mode_t mode;
+    uint8_t frame;          // Shown frame
+    uint8_t is_shown;
+    int16_t x;              // Shown position
+    int16_t y;
+    int16_t save_x;         // Saved background, columns x pages
+    int16_t save_page;
+    int16_t save_w;
+    int16_t save_pages;
+} lib_u8g2_sprite_t;
+
+/**
+ * @brief Initialize hidden sprite.
+ *
+ * @param p_sprite Sprite.
+ * @param p_buf Buffer of LIB_U8G2_SPRITE_BUF_SIZE() bytes.
+ * @param w Sprite width.
+ * @param h Sprite height.
+ * @param frame_cnt Number of frames.
+ * @param bitmap XBM bitmap of w x (h * frame_cnt) pixels, frames stacked
+ *               vertically.
+ * @param mask XBM mask of the same size, used in masked mode, may be NULL.
+ * @param mode Drawing mode.
+ */
+void
+lib_u8g2_SpriteInit(lib_u8g2_sprite_t *p_sprite, uint8_t *p_buf, uint8_t w,
+    uint8_t h, uint8_t frame_cnt, const uint8_t *bitmap, const uint8_t *mask,
+    lib_u8g2_sprite_mode_t mode);
+
+/**
+ * @brief Draw sprite at given position, erasing it at the previous one.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param p_sprite Sprite.
+ * @param x Left column.
+ * @param y Top row.
+ *
+ * @return 1 on success, 0 if frame buffer is not supported.
+ */
+uint8_t
+lib_u8g2_SpriteMove(u8g2_t *u8g2, lib_u8g2_sprite_t *p_sprite, int16_t x,
+    int16_t y);
+
+/**
+ * @brief Change shown frame of sprite.
+ */
+void
+lib_u8g2_SpriteSetFrame(u8g2_t *u8g2, lib_u8g2_sprite_t *p_sprite,
+    uint8_t frame);
+
+/**
+ * @brief Erase sprite.
+ */
+void
+lib_u8g2_SpriteHide(u8g2_t *u8g2, lib_u8g2_sprite_t *p_sprite);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_SPRITE_H
+
+/* [] END OF FILE */
@@ -0,0 +1,71 @@
+/***************************************************************************//**
+* @file    lib_u8g2_stream.h
+* @version 1.0.0
+*
+* @brief Compressed images streamed to display without frame buffer.
+*
+* Images are stored page-major, in the same byte order as SSD1306 display
+* RAM and u8x8 tiles: page 0 columns left to right, then page 1 and so on,
+* one byte holds 8 vertical pixels with the top pixel in bit 0. Image data
+* is decoded in chunks of tiles and sent by u8x8_DrawTile(), frame buffer
+* is neither used nor changed. Suitable for boot splash shown before first
+* frame is rendered.
+*
+* Image format:
+*    byte 0       LIB_U8G2_STREAM_RAW or LIB_U8G2_STREAM_RLE
+*    byte 1       Width in tiles (8 pixel columns)
+*    byte 2       Height in tiles (8 pixel pages)
+*    byte 3...    Image data, RLE control byte 0x00 - 0x7F is followed by
+*                 1 - 128 literal bytes, control byte 0x80 - 0xFF by one
+*                 byte repeated 2 - 129 times
+*
+* Images are created from XBM files by tools/image_pack host tool.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_STREAM_H
+#define LIB_U8G2_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Number of tiles decoded and sent at once, decode buffer takes 8 bytes
+ * per tile of stack.
+ */
+#ifndef LIB_U8G2_STREAM_CHUNK_TILES
+#define LIB_U8G2_STREAM_CHUNK_TILES         (16u)
+#endif
+
+/**
+ * @brief Image data formats.
+ */
+#define LIB_U8G2_STREAM_RAW                 (0u)
+#define LIB_U8G2_STREAM_RLE                 (1u)
+
+/**
+ * @brief Decode image and send it directly to display.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param tx Left tile column of image on display.
+ * @param ty Top tile row (page) of image on display.
+ * @param p_image Image in the format described above.
+ *
+ * @return 1 on success, 0 if image format is not supported.
+ */
+uint8_t
+lib_u8g2_StreamImage(u8g2_t *u8g2, uint8_t tx, uint8_t ty,
+    const uint8_t *p_image);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_STREAM_H
+
+/* [] END OF FILE */
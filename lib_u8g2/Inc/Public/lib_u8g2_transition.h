@@ -0,0 +1,115 @@
+/***************************************************************************//**
+* @file    lib_u8g2_transition.h
+* @version 1.0.0
+*
+* @brief Screen transitions using SSD1306 commands.
+*
+* Fades ramp display contrast, flashes toggle inverse display mode (A6h/A7h)
+* and slides move display start line. Steps of fades and flashes cost one
+* command. Slides send new screen once: on displays with at most 32 rows it
+* is written to hidden display RAM rows first and each step is a single
+* start line command, on taller displays each step also sends the RAM pages
+* uncovered by that step.
+*
+* Transition is advanced by lib_u8g2_TransitionStep(), typically called from
+* a timer event handler, or run to completion by lib_u8g2_TransitionRun().
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_TRANSITION_H
+#define LIB_U8G2_TRANSITION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Display contrast used as fade limit until lib_u8g2_SetContrastLevel() is
+ * called, matches u8g2 SSD1306 initialization.
+ */
+#ifndef LIB_U8G2_TRANSITION_DEFAULT_CONTRAST
+#define LIB_U8G2_TRANSITION_DEFAULT_CONTRAST    (0xCFu)
+#endif
+
+/**
+ * @brief Transition types.
+ */
+typedef enum
+{
+    LIB_U8G2_TRANSITION_FADE_OUT,   // Contrast down to zero, display off
+    LIB_U8G2_TRANSITION_FADE_IN,    // Display on, contrast up to set level
+    LIB_U8G2_TRANSITION_FLASH,      // Toggle inverse mode
+    LIB_U8G2_TRANSITION_SLIDE_UP,   // Frame buffer slides in from bottom
+    LIB_U8G2_TRANSITION_SLIDE_DOWN  // Frame buffer slides in from top
+} lib_u8g2_transition_t;
+
+/**
+ * @brief Set display contrast and remember it as fade limit.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param level Contrast level.
+ */
+void
+lib_u8g2_SetContrastLevel(u8g2_t *u8g2, uint8_t level);
+
+/**
+ * @brief Set inverse display mode and remember it as flash base state.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param is_inverse 1 for inverse mode, 0 for normal mode.
+ */
+void
+lib_u8g2_SetInverse(u8g2_t *u8g2, uint8_t is_inverse);
+
+/**
+ * @brief Start transition.
+ *
+ * Slides show current frame buffer content, render new screen to frame
+ * buffer before starting slide and do not send it by u8g2_SendBuffer().
+ * Slides require full frame buffer, see lib_u8g2_scroll.h.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param type Transition type.
+ * @param steps Number of steps, flash toggles inverse mode each step.
+ *
+ * @return 1 on success, 0 if transition is not supported.
+ */
+uint8_t
+lib_u8g2_TransitionStart(u8g2_t *u8g2, lib_u8g2_transition_t type,
+    uint8_t steps);
+
+/**
+ * @brief Do one step of running transition.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ *
+ * @return 1 if transition continues, 0 if it is finished.
+ */
+uint8_t
+lib_u8g2_TransitionStep(u8g2_t *u8g2);
+
+/**
+ * @brief Run whole transition, waiting step_ms milliseconds between steps.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param type Transition type.
+ * @param steps Number of steps.
+ * @param step_ms Step period in milliseconds.
+ *
+ * @return 1 on success, 0 if transition is not supported.
+ */
+uint8_t
+lib_u8g2_TransitionRun(u8g2_t *u8g2, lib_u8g2_transition_t type,
+    uint8_t steps, uint8_t step_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_TRANSITION_H
+
+/* [] END OF FILE */
@@ -0,0 +1,217 @@
+/***************************************************************************//**
+* @file    lib_u8g2_widget.h
+* @version 1.0.0
+*
+* @brief Retained mode widgets with per-widget dirty rectangles.
+*
+* Widgets are kept in a screen list and remember their bounding box and
+* shown value. Setting a value marks the widget dirty only if its picture
+* changes, progress bars mark only the changed part of the bar. Screen
+* update handles dirty rectangles one by one, it clears the rectangle,
+* redraws widgets touching it and sends tiles covering it to display.
+* Widgets are drawn clipped to their boxes, text longer than its box is
+* cut off.
+*
+* With dirty area tracking active (lib_u8g2_dirty.h) screen update sends
+* each rectangle by lib_u8g2_SendDirty(), so sent tiles are not sent again
+* and LIB_U8G2_DIRTY_COMPARE shadow stays valid. Other changes recorded
+* since the last send go out with the first rectangle.
+*
+* Widget and screen structures are owned by application, no memory is
+* allocated. Partial updates require full frame buffer.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#ifndef LIB_U8G2_WIDGET_H
+#define LIB_U8G2_WIDGET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <lib_u8g2.h>
+
+/**
+ * Maximum text length of label and number widgets including terminating
+ * zero, longer texts are truncated.
+ */
+#ifndef LIB_U8G2_WIDGET_TEXT_SIZE
+#define LIB_U8G2_WIDGET_TEXT_SIZE           (24u)
+#endif
+
+/**
+ * @brief Widget types.
+ */
+typedef enum
+{
+    LIB_U8G2_WIDGET_LABEL,
+    LIB_U8G2_WIDGET_NUMBER,
+    LIB_U8G2_WIDGET_BITMAP,
+    LIB_U8G2_WIDGET_PROGRESS,
+    LIB_U8G2_WIDGET_FRAME
+} lib_u8g2_widget_type_t;
+
+/**
+ * @brief Horizontal text alignment within widget box.
+ */
+typedef enum
+{
+    LIB_U8G2_ALIGN_LEFT,
+    LIB_U8G2_ALIGN_CENTER,
+    LIB_U8G2_ALIGN_RIGHT
+} lib_u8g2_align_t;
+
+/**
+ * @brief Widget, fields are private to the module.
+ */
+typedef struct lib_u8g2_widget_s
+{
+    struct lib_u8g2_widget_s *p_next;
+    lib_u8g2_widget_type_t type;
+    int16_t x;              // Bounding box
+    int16_t y;
+    int16_t w;
+    int16_t h;
+    int16_t dirty_x0;       // Dirty columns of box, empty if x0 >= x1
+    int16_t dirty_x1;
+    union
+    {
+        struct
+        {
+            const uint8_t *font;
+            lib_u8g2_align_t align;
+            uint8_t decimals;
+            char text[LIB_U8G2_WIDGET_TEXT_SIZE];
+        } text;
+        const uint8_t *bitmap;  // XBM bitmap of box size
+        struct
+        {
+            uint16_t value;
+            uint16_t max;
+            int16_t fill_w; // Filled bar width shown
+        } progress;
+    } data;
+} lib_u8g2_widget_t;
+
+/**
+ * @brief Screen holding list of widgets.
+ */
+typedef struct
+{
+    lib_u8g2_widget_t *p_first;
+    lib_u8g2_widget_t *p_last;
+} lib_u8g2_screen_t;
+
+/**
+ * @brief Initialize empty screen.
+ */
+void
+lib_u8g2_ScreenInit(lib_u8g2_screen_t *p_screen);
+
+/**
+ * @brief Append initialized widget to screen, widgets are drawn in order.
+ */
+void
+lib_u8g2_ScreenAdd(lib_u8g2_screen_t *p_screen, lib_u8g2_widget_t *p_widget);
+
+/**
+ * @brief Draw all screen widgets to cleared frame buffer.
+ *
+ * Frame buffer is not sent, use u8g2_SendBuffer() or a transition.
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param p_screen Screen to draw.
+ */
+void
+lib_u8g2_ScreenDraw(u8g2_t *u8g2, lib_u8g2_screen_t *p_screen);
+
+/**
+ * @brief Redraw and send dirty parts of screen.
+ *
+ * With dirty area tracking active, areas recorded by tracking are sent
+ * as well, see lib_u8g2_SendDirty().
+ *
+ * @param u8g2 u8g2 display descriptor.
+ * @param p_screen Screen to update.
+ *
+ * @return 1 if anything was redrawn, 0 otherwise.
+ */
+uint8_t
+lib_u8g2_ScreenUpdate(u8g2_t *u8g2, lib_u8g2_screen_t *p_screen);
+
+/**
+ * @brief Initialize text label, text is copied.
+ */
+void
+lib_u8g2_InitLabel(lib_u8g2_widget_t *p_widget, int16_t x, int16_t y,
+    int16_t w, int16_t h, const uint8_t *font, lib_u8g2_align_t align,
+    const char *text);
+
+/**
+ * @brief Initialize numeric field showing value with given decimal places.
+ */
+void
+lib_u8g2_InitNumber(lib_u8g2_widget_t *p_widget, int16_t x, int16_t y,
+    int16_t w, int16_t h, const uint8_t *font, lib_u8g2_align_t align,
+    uint8_t decimals);
+
+/**
+ * @brief Initialize bitmap, XBM bitmap size equals box size.
+ */
+void
+lib_u8g2_InitBitmap(lib_u8g2_widget_t *p_widget, int16_t x, int16_t y,
+    int16_t w, int16_t h, const uint8_t *bitmap);
+
+/**
+ * @brief Initialize horizontal progress bar with range 0 to max.
+ */
+void
+lib_u8g2_InitProgress(lib_u8g2_widget_t *p_widget, int16_t x, int16_t y,
+    int16_t w, int16_t h, uint16_t max);
+
+/**
+ * @brief Initialize frame outline.
+ */
+void
+lib_u8g2_InitFrame(lib_u8g2_widget_t *p_widget, int16_t x, int16_t y,
+    int16_t w, int16_t h);
+
+/**
+ * @brief Set label text.
+ */
+void
+lib_u8g2_SetLabel(lib_u8g2_widget_t *p_widget, const char *text);
+
+/**
+ * @brief Set numeric field value, e.g. 1234 with 2 decimals shows 12.34
+ */
+void
+lib_u8g2_SetNumber(lib_u8g2_widget_t *p_widget, int32_t value);
+
+/**
+ * @brief Set bitmap data.
+ */
+void
+lib_u8g2_SetBitmap(lib_u8g2_widget_t *p_widget, const uint8_t *bitmap);
+
+/**
+ * @brief Set progress bar value.
+ */
+void
+lib_u8g2_SetProgress(lib_u8g2_widget_t *p_widget, uint16_t value);
+
+/**
+ * @brief Mark whole widget for redraw.
+ */
+void
+lib_u8g2_InvalidateWidget(lib_u8g2_widget_t *p_widget);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIB_U8G2_WIDGET_H
+
+/* [] END OF FILE */
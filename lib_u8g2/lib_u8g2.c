@@ -105,20 +105,21 @@ lib_u8g2_custom_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
         break;
 
         case U8X8_MSG_DELAY_MILLI:
+            // Delay of arg_int milliseconds
             sleep_time.tv_sec = 0;
-            sleep_time.tv_nsec = 1000000;
+            sleep_time.tv_nsec = (long)arg_int * 1000000;
             nanosleep(&sleep_time, NULL);
         break;
 
         case U8X8_MSG_DELAY_10MICRO:
             sleep_time.tv_sec = 0;
-            sleep_time.tv_nsec = 10000;
+            sleep_time.tv_nsec = (long)arg_int * 10000;
             nanosleep(&sleep_time, NULL);
         break;
 
         case U8X8_MSG_DELAY_100NANO:
             sleep_time.tv_sec = 0;
-            sleep_time.tv_nsec = 100;
+            sleep_time.tv_nsec = (long)arg_int * 100;
             nanosleep(&sleep_time, NULL);
         break;
 
@@ -0,0 +1,223 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_anim.c
+* @version 1.0.0
+*
+* @brief Frame paced animation of values.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <time.h>
+
+#include <lib_u8g2_anim.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+// Tween progress fixed point, 1.0 is 1024
+#define PROGRESS_SHIFT          (10)
+#define PROGRESS_ONE            (1 << PROGRESS_SHIFT)
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static uint32_t
+now_ms(void);
+
+static int32_t
+ease(lib_u8g2_ease_t type, int32_t p);
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+
+static lib_u8g2_tween_t *g_p_first;     // Running tweens
+static uint16_t g_fps = LIB_U8G2_ANIM_DEFAULT_FPS;
+static uint32_t g_epoch_ms;             // Time of frame 0
+static uint32_t g_frame;                // Last drawn frame
+static uint32_t g_dropped;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void
+lib_u8g2_AnimSetFrameRate(uint16_t fps)
+{
+    if (fps > 0)
+    {
+        g_fps = fps;
+    }
+}
+
+uint32_t
+lib_u8g2_AnimGetFramePeriodNs(void)
+{
+    return 1000000000ul / g_fps;
+}
+
+void
+lib_u8g2_AnimStart(lib_u8g2_tween_t *p_tween, int16_t *p_value,
+    int16_t from, int16_t to, uint32_t duration_ms, lib_u8g2_ease_t ease)
+{
+    uint32_t now = now_ms();
+
+    if (g_p_first == NULL)
+    {
+        // Frame deadlines start with first running tween
+        g_epoch_ms = now;
+        g_frame = 0;
+    }
+
+    lib_u8g2_AnimStop(p_tween);
+
+    p_tween->p_value = p_value;
+    p_tween->from = from;
+    p_tween->to = to;
+    p_tween->start_ms = now;
+    p_tween->duration_ms = duration_ms;
+    p_tween->ease = ease;
+    p_tween->is_running = 1;
+    p_tween->p_next = g_p_first;
+    g_p_first = p_tween;
+
+    *p_value = from;
+}
+
+void
+lib_u8g2_AnimStop(lib_u8g2_tween_t *p_tween)
+{
+    lib_u8g2_tween_t **pp_link = &g_p_first;
+
+    while (*pp_link != NULL)
+    {
+        if (*pp_link == p_tween)
+        {
+            *pp_link = p_tween->p_next;
+            break;
+        }
+        pp_link = &(*pp_link)->p_next;
+    }
+
+    p_tween->is_running = 0;
+}
+
+uint8_t
+lib_u8g2_AnimIsRunning(void)
+{
+    return (uint8_t)(g_p_first != NULL);
+}
+
+uint8_t
+lib_u8g2_AnimTick(void)
+{
+    return lib_u8g2_AnimTickAt(now_ms());
+}
+
+uint8_t
+lib_u8g2_AnimTickAt(uint32_t now)
+{
+    lib_u8g2_tween_t *p_tween = g_p_first;
+    lib_u8g2_tween_t *p_next;
+    uint32_t frame;
+    uint32_t elapsed;
+    int16_t value;
+    uint8_t is_changed = 0;
+
+    if (p_tween == NULL)
+    {
+        return 0;
+    }
+
+    // Frame due at current time, timer ticks may come early or late
+    frame = (uint32_t)((uint64_t)(now - g_epoch_ms) * g_fps / 1000u);
+    if (frame <= g_frame)
+    {
+        return 0;
+    }
+
+    g_dropped += frame - g_frame - 1;
+    g_frame = frame;
+
+    while (p_tween != NULL)
+    {
+        p_next = p_tween->p_next;
+        elapsed = now - p_tween->start_ms;
+
+        if (elapsed >= p_tween->duration_ms)
+        {
+            value = p_tween->to;
+            lib_u8g2_AnimStop(p_tween);
+        }
+        else
+        {
+            value = (int16_t)(p_tween->from + (((int32_t)p_tween->to -
+                p_tween->from) * ease(p_tween->ease, (int32_t)(((uint64_t)
+                elapsed << PROGRESS_SHIFT) / p_tween->duration_ms)) /
+                PROGRESS_ONE));
+        }
+
+        if (*p_tween->p_value != value)
+        {
+            *p_tween->p_value = value;
+            is_changed = 1;
+        }
+
+        p_tween = p_next;
+    }
+
+    return is_changed;
+}
+
+uint32_t
+lib_u8g2_AnimGetDropped(void)
+{
+    return g_dropped;
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static uint32_t
+now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000u +
+        (uint64_t)ts.tv_nsec / 1000000u);
+}
+
+static int32_t
+ease(lib_u8g2_ease_t type, int32_t p)
+{
+    int32_t q;
+
+    switch (type)
+    {
+    case LIB_U8G2_EASE_IN:
+        return (p * p) >> PROGRESS_SHIFT;
+
+    case LIB_U8G2_EASE_OUT:
+        q = PROGRESS_ONE - p;
+        return PROGRESS_ONE - ((q * q) >> PROGRESS_SHIFT);
+
+    case LIB_U8G2_EASE_IN_OUT:
+        if (p < PROGRESS_ONE / 2)
+        {
+            return (2 * p * p) >> PROGRESS_SHIFT;
+        }
+        q = PROGRESS_ONE - p;
+        return PROGRESS_ONE - ((2 * q * q) >> PROGRESS_SHIFT);
+
+    default:
+        return p;
+    }
+}
+
+/* [] END OF FILE */
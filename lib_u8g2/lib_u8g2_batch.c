@@ -0,0 +1,234 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_batch.c
+* @version 1.0.0
+*
+* @brief Batched drawing of pixels, bars, line strips and boxes.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <stdlib.h>
+
+#include <lib_u8g2_batch.h>
+#include <lib_u8g2_span.h>
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static void
+draw_segment(const lib_u8g2_span_t *p_span, int16_t x0, int16_t y0,
+    int16_t x1, int16_t y1, uint8_t skip_first, uint8_t skip_last);
+
+static void
+fill_run(const lib_u8g2_span_t *p_span, uint8_t is_steep, int32_t run_a,
+    int32_t run_b, int32_t pos);
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void
+lib_u8g2_DrawPixels(u8g2_t *u8g2, const lib_u8g2_point_t *points,
+    uint16_t count)
+{
+    lib_u8g2_span_t span;
+
+    lib_u8g2_SpanBegin(&span, u8g2);
+    for (uint16_t i = 0; i < count; i++)
+    {
+        lib_u8g2_SpanPixel(&span, points[i].x, points[i].y);
+    }
+}
+
+void
+lib_u8g2_DrawVBars(u8g2_t *u8g2, int16_t x, int16_t y_base, int16_t bar_w,
+    int16_t pitch, const int16_t *y_values, uint16_t count)
+{
+    lib_u8g2_span_t span;
+    int32_t bar_x = x;
+
+    lib_u8g2_SpanBegin(&span, u8g2);
+    for (uint16_t i = 0; i < count; i++, bar_x += pitch)
+    {
+        if ((bar_x >= span.x1) || (bar_x + bar_w <= span.x0))
+        {
+            continue;
+        }
+
+        if (y_values[i] < y_base)
+        {
+            lib_u8g2_SpanFill(&span, (int16_t)bar_x, y_values[i],
+                (int16_t)(bar_x + bar_w), y_base);
+        }
+        else if (y_values[i] > y_base)
+        {
+            // Rows y_base + 1 to y_values[i], mirror of bars growing up
+            lib_u8g2_SpanFill(&span, (int16_t)bar_x, (int16_t)(y_base + 1),
+                (int16_t)(bar_x + bar_w), (int16_t)(y_values[i] + 1));
+        }
+    }
+}
+
+void
+lib_u8g2_DrawLineStrip(u8g2_t *u8g2, const lib_u8g2_point_t *points,
+    uint16_t count)
+{
+    lib_u8g2_span_t span;
+    uint8_t is_closed;
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    lib_u8g2_SpanBegin(&span, u8g2);
+    if (count == 1)
+    {
+        lib_u8g2_SpanPixel(&span, points[0].x, points[0].y);
+        return;
+    }
+
+    // Last vertex of closed strip was already drawn as the first one
+    is_closed = (uint8_t)((count > 2) &&
+        (points[count - 1].x == points[0].x) &&
+        (points[count - 1].y == points[0].y));
+
+    for (uint16_t i = 0; i + 1 < count; i++)
+    {
+        draw_segment(&span, points[i].x, points[i].y,
+            points[i + 1].x, points[i + 1].y, (uint8_t)(i > 0),
+            (uint8_t)(is_closed && (i + 2 == count)));
+    }
+}
+
+void
+lib_u8g2_DrawTrace(u8g2_t *u8g2, int16_t x, const int16_t *y_values,
+    uint16_t count)
+{
+    lib_u8g2_span_t span;
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    lib_u8g2_SpanBegin(&span, u8g2);
+    if (count == 1)
+    {
+        lib_u8g2_SpanPixel(&span, x, y_values[0]);
+        return;
+    }
+
+    for (uint16_t i = 0; i + 1 < count; i++)
+    {
+        draw_segment(&span, (int16_t)(x + i), y_values[i],
+            (int16_t)(x + i + 1), y_values[i + 1], (uint8_t)(i > 0), 0);
+    }
+}
+
+void
+lib_u8g2_DrawBoxes(u8g2_t *u8g2, const lib_u8g2_box_t *boxes,
+    uint16_t count)
+{
+    lib_u8g2_span_t span;
+
+    lib_u8g2_SpanBegin(&span, u8g2);
+    for (uint16_t i = 0; i < count; i++)
+    {
+        lib_u8g2_SpanFill(&span, boxes[i].x, boxes[i].y,
+            (int16_t)(boxes[i].x + boxes[i].w),
+            (int16_t)(boxes[i].y + boxes[i].h));
+    }
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static void
+draw_segment(const lib_u8g2_span_t *p_span, int16_t x0, int16_t y0,
+    int16_t x1, int16_t y1, uint8_t skip_first, uint8_t skip_last)
+{
+    int32_t a0 = x0;        // Major axis
+    int32_t b0 = y0;        // Minor axis
+    int32_t a1 = x1;
+    int32_t b1 = y1;
+    int32_t da;
+    int32_t db;
+    int32_t err;
+    int32_t step;
+    int32_t run_start;
+    int32_t tmp;
+    uint8_t is_steep;
+
+    // Segment completely outside of visible area
+    if (((x0 < p_span->x0) && (x1 < p_span->x0)) ||
+        ((x0 >= p_span->x1) && (x1 >= p_span->x1)) ||
+        ((y0 < p_span->y0) && (y1 < p_span->y0)) ||
+        ((y0 >= p_span->y1) && (y1 >= p_span->y1)))
+    {
+        return;
+    }
+
+    // Same normalization as u8g2_DrawLine() to select the same pixels
+    is_steep = (uint8_t)(abs(y1 - y0) > abs(x1 - x0));
+    if (is_steep)
+    {
+        a0 = y0;
+        b0 = x0;
+        a1 = y1;
+        b1 = x1;
+    }
+    if (a0 > a1)
+    {
+        tmp = a0; a0 = a1; a1 = tmp;
+        tmp = b0; b0 = b1; b1 = tmp;
+        tmp = skip_first; skip_first = skip_last; skip_last = (uint8_t)tmp;
+    }
+
+    da = a1 - a0;
+    db = labs(b1 - b0);
+    err = da >> 1;
+    step = (b1 > b0) ? 1 : -1;
+
+    // Emit one run per minor axis position
+    run_start = a0;
+    for (int32_t a = a0; a <= a1; a++)
+    {
+        err -= db;
+        if ((err < 0) || (a == a1))
+        {
+            fill_run(p_span, is_steep,
+                (skip_first && (run_start == a0)) ? run_start + 1 : run_start,
+                (skip_last && (a == a1)) ? a : a + 1, b0);
+            b0 += step;
+            err += da;
+            run_start = a + 1;
+        }
+    }
+}
+
+static void
+fill_run(const lib_u8g2_span_t *p_span, uint8_t is_steep, int32_t run_a,
+    int32_t run_b, int32_t pos)
+{
+    if (run_a >= run_b)
+    {
+        return;
+    }
+
+    if (is_steep)
+    {
+        lib_u8g2_SpanFill(p_span, (int16_t)pos, (int16_t)run_a,
+            (int16_t)(pos + 1), (int16_t)run_b);
+    }
+    else
+    {
+        lib_u8g2_SpanFill(p_span, (int16_t)run_a, (int16_t)pos,
+            (int16_t)run_b, (int16_t)(pos + 1));
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,437 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_cache.c
+* @version 1.0.0
+*
+* @brief Cache of pre-rendered screens.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <string.h>
+
+#include <lib_u8g2_cache.h>
+#include <lib_u8g2_dirty.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+// Control byte 0x00 - 0x7F: 1 - 128 literal bytes follow
+// Control byte 0x80 - 0xFF: next byte repeats 2 - 129 times
+#define RLE_MAX_LITERAL         (128u)
+#define RLE_MAX_RUN             (129u)
+#define RLE_RUN_FLAG            (0x80u)
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static uint16_t
+frame_size(u8g2_t *u8g2);
+
+static lib_u8g2_cache_entry_t *
+find(lib_u8g2_cache_t *p_cache, uint8_t screen_id, uint16_t version);
+
+static uint8_t
+store(u8g2_t *u8g2, lib_u8g2_cache_t *p_cache, uint8_t screen_id,
+    uint16_t version, const lib_u8g2_cache_entry_t *p_keep);
+
+static void
+load(u8g2_t *u8g2, lib_u8g2_cache_t *p_cache, lib_u8g2_cache_entry_t *p_entry);
+
+static lib_u8g2_cache_entry_t *
+alloc(lib_u8g2_cache_t *p_cache, uint16_t len,
+    const lib_u8g2_cache_entry_t *p_keep);
+
+static void
+evict(lib_u8g2_cache_t *p_cache, lib_u8g2_cache_entry_t *p_entry);
+
+static uint16_t
+rle_encode(const uint8_t *p_src, uint16_t len, uint8_t *p_dst);
+
+static void
+rle_decode(const uint8_t *p_src, uint8_t *p_dst, uint16_t len);
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void
+lib_u8g2_CacheInit(lib_u8g2_cache_t *p_cache, uint8_t *p_buf, uint16_t size,
+    lib_u8g2_render_cb render)
+{
+    memset(p_cache, 0, sizeof(lib_u8g2_cache_t));
+    p_cache->p_buf = p_buf;
+    p_cache->size = size;
+    p_cache->render = render;
+}
+
+uint8_t
+lib_u8g2_CacheShow(u8g2_t *u8g2, lib_u8g2_cache_t *p_cache,
+    uint8_t screen_id, uint16_t version)
+{
+    lib_u8g2_cache_entry_t *p_entry;
+
+    if (p_cache->is_shown && (p_cache->shown_id == screen_id) &&
+        (p_cache->shown_version == version))
+    {
+        return 0;
+    }
+
+    if (frame_size(u8g2) == 0)
+    {
+        return 0;
+    }
+
+    p_entry = find(p_cache, screen_id, version);
+    if (p_entry != NULL)
+    {
+        load(u8g2, p_cache, p_entry);
+        lib_u8g2_MarkDirty(u8g2, 0, 0, (int16_t)u8g2_GetDisplayWidth(u8g2),
+            (int16_t)u8g2_GetDisplayHeight(u8g2));
+    }
+    else
+    {
+        p_cache->render(u8g2, screen_id);
+        store(u8g2, p_cache, screen_id, version, NULL);
+    }
+
+    p_cache->shown_id = screen_id;
+    p_cache->shown_version = version;
+    p_cache->is_shown = 1;
+
+    return 1;
+}
+
+uint8_t
+lib_u8g2_CacheStore(u8g2_t *u8g2, lib_u8g2_cache_t *p_cache,
+    uint8_t screen_id, uint16_t version)
+{
+    if (frame_size(u8g2) == 0)
+    {
+        return 0;
+    }
+
+    return store(u8g2, p_cache, screen_id, version, NULL);
+}
+
+void
+lib_u8g2_CacheInvalidate(lib_u8g2_cache_t *p_cache, uint8_t screen_id)
+{
+    for (uint8_t i = 0; i < LIB_U8G2_CACHE_ENTRIES; i++)
+    {
+        if ((p_cache->entries[i].len != 0) &&
+            (p_cache->entries[i].screen_id == screen_id))
+        {
+            evict(p_cache, &p_cache->entries[i]);
+        }
+    }
+
+    if (p_cache->shown_id == screen_id)
+    {
+        p_cache->is_shown = 0;
+    }
+}
+
+void
+lib_u8g2_CacheForgetShown(lib_u8g2_cache_t *p_cache)
+{
+    p_cache->is_shown = 0;
+}
+
+void
+lib_u8g2_CachePredict(lib_u8g2_cache_t *p_cache, uint8_t screen_id,
+    uint16_t version)
+{
+    p_cache->next_id = screen_id;
+    p_cache->next_version = version;
+    p_cache->is_next = 1;
+}
+
+uint8_t
+lib_u8g2_CacheIdle(u8g2_t *u8g2, lib_u8g2_cache_t *p_cache)
+{
+    lib_u8g2_cache_entry_t *p_shown;
+
+    if (!p_cache->is_next || !p_cache->is_shown ||
+        (frame_size(u8g2) == 0))
+    {
+        return 0;
+    }
+
+    p_cache->is_next = 0;
+    if (find(p_cache, p_cache->next_id, p_cache->next_version) != NULL)
+    {
+        return 0;
+    }
+
+    // Shown screen is needed to restore frame buffer
+    p_shown = find(p_cache, p_cache->shown_id, p_cache->shown_version);
+    if (p_shown == NULL)
+    {
+        return 0;
+    }
+
+    lib_u8g2_PauseDirty(1);
+    p_cache->render(u8g2, p_cache->next_id);
+    store(u8g2, p_cache, p_cache->next_id, p_cache->next_version, p_shown);
+    load(u8g2, p_cache, p_shown);
+    lib_u8g2_PauseDirty(0);
+
+    return 1;
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static uint16_t
+frame_size(u8g2_t *u8g2)
+{
+    // Full frame buffer only
+    if (u8g2->tile_buf_height != u8x8_GetRows(u8g2_GetU8x8(u8g2)))
+    {
+        return 0;
+    }
+
+    return (uint16_t)(u8g2->tile_buf_height * u8g2->pixel_buf_width);
+}
+
+static lib_u8g2_cache_entry_t *
+find(lib_u8g2_cache_t *p_cache, uint8_t screen_id, uint16_t version)
+{
+    for (uint8_t i = 0; i < LIB_U8G2_CACHE_ENTRIES; i++)
+    {
+        if ((p_cache->entries[i].len != 0) &&
+            (p_cache->entries[i].screen_id == screen_id) &&
+            (p_cache->entries[i].version == version))
+        {
+            return &p_cache->entries[i];
+        }
+    }
+
+    return NULL;
+}
+
+static uint8_t
+store(u8g2_t *u8g2, lib_u8g2_cache_t *p_cache, uint8_t screen_id,
+    uint16_t version, const lib_u8g2_cache_entry_t *p_keep)
+{
+    lib_u8g2_cache_entry_t *p_entry;
+    uint16_t size = frame_size(u8g2);
+    uint16_t len = rle_encode(u8g2->tile_buf_ptr, size, NULL);
+    uint8_t is_rle = (len < size);
+
+    if (!is_rle)
+    {
+        len = size;
+    }
+
+    // Older versions of the screen are not needed
+    for (uint8_t i = 0; i < LIB_U8G2_CACHE_ENTRIES; i++)
+    {
+        if ((p_cache->entries[i].len != 0) &&
+            (p_cache->entries[i].screen_id == screen_id) &&
+            (&p_cache->entries[i] != p_keep))
+        {
+            evict(p_cache, &p_cache->entries[i]);
+        }
+    }
+
+    p_entry = alloc(p_cache, len, p_keep);
+    if (p_entry == NULL)
+    {
+        return 0;
+    }
+
+    if (is_rle)
+    {
+        rle_encode(u8g2->tile_buf_ptr, size, p_cache->p_buf + p_cache->used);
+    }
+    else
+    {
+        memcpy(p_cache->p_buf + p_cache->used, u8g2->tile_buf_ptr, size);
+    }
+
+    p_entry->offset = p_cache->used;
+    p_entry->len = len;
+    p_entry->version = version;
+    p_entry->last_use = ++p_cache->use_cnt;
+    p_entry->screen_id = screen_id;
+    p_entry->is_rle = is_rle;
+    p_cache->used = (uint16_t)(p_cache->used + len);
+
+    return 1;
+}
+
+static void
+load(u8g2_t *u8g2, lib_u8g2_cache_t *p_cache, lib_u8g2_cache_entry_t *p_entry)
+{
+    const uint8_t *p_data = p_cache->p_buf + p_entry->offset;
+
+    if (p_entry->is_rle)
+    {
+        rle_decode(p_data, u8g2->tile_buf_ptr, frame_size(u8g2));
+    }
+    else
+    {
+        memcpy(u8g2->tile_buf_ptr, p_data, p_entry->len);
+    }
+
+    p_entry->last_use = ++p_cache->use_cnt;
+}
+
+static lib_u8g2_cache_entry_t *
+alloc(lib_u8g2_cache_t *p_cache, uint16_t len,
+    const lib_u8g2_cache_entry_t *p_keep)
+{
+    lib_u8g2_cache_entry_t *p_free;
+    lib_u8g2_cache_entry_t *p_oldest;
+    uint16_t age;
+    uint16_t oldest_age;
+
+    if (len > p_cache->size)
+    {
+        return NULL;
+    }
+
+    for (;;)
+    {
+        p_free = NULL;
+        p_oldest = NULL;
+        oldest_age = 0;
+
+        for (uint8_t i = 0; i < LIB_U8G2_CACHE_ENTRIES; i++)
+        {
+            lib_u8g2_cache_entry_t *p_entry = &p_cache->entries[i];
+
+            if (p_entry->len == 0)
+            {
+                p_free = p_entry;
+            }
+            else if (p_entry != p_keep)
+            {
+                // Wrap around safe age
+                age = (uint16_t)(p_cache->use_cnt - p_entry->last_use);
+                if ((p_oldest == NULL) || (age >= oldest_age))
+                {
+                    p_oldest = p_entry;
+                    oldest_age = age;
+                }
+            }
+        }
+
+        if ((p_free != NULL) && (p_cache->size - p_cache->used >= len))
+        {
+            return p_free;
+        }
+
+        if (p_oldest == NULL)
+        {
+            return NULL;
+        }
+
+        evict(p_cache, p_oldest);
+    }
+}
+
+static void
+evict(lib_u8g2_cache_t *p_cache, lib_u8g2_cache_entry_t *p_entry)
+{
+    uint16_t end = (uint16_t)(p_entry->offset + p_entry->len);
+
+    // Keep data packed, move entries behind the evicted one down
+    memmove(p_cache->p_buf + p_entry->offset, p_cache->p_buf + end,
+        (size_t)(p_cache->used - end));
+
+    for (uint8_t i = 0; i < LIB_U8G2_CACHE_ENTRIES; i++)
+    {
+        if ((p_cache->entries[i].len != 0) &&
+            (p_cache->entries[i].offset > p_entry->offset))
+        {
+            p_cache->entries[i].offset =
+                (uint16_t)(p_cache->entries[i].offset - p_entry->len);
+        }
+    }
+
+    p_cache->used = (uint16_t)(p_cache->used - p_entry->len);
+    p_entry->len = 0;
+}
+
+static uint16_t
+rle_encode(const uint8_t *p_src, uint16_t len, uint8_t *p_dst)
+{
+    uint16_t pos = 0;
+    uint16_t out = 0;
+    uint16_t cnt;
+
+    while (pos < len)
+    {
+        cnt = 1;
+        while ((pos + cnt < len) && (cnt < RLE_MAX_RUN) &&
+            (p_src[pos + cnt] == p_src[pos]))
+        {
+            cnt++;
+        }
+
+        if (cnt >= 2)
+        {
+            if (p_dst != NULL)
+            {
+                p_dst[out] = (uint8_t)(RLE_RUN_FLAG | (cnt - 2));
+                p_dst[out + 1] = p_src[pos];
+            }
+            out = (uint16_t)(out + 2);
+        }
+        else
+        {
+            // Literal bytes up to the start of next run
+            while ((pos + cnt < len) && (cnt < RLE_MAX_LITERAL) &&
+                !((pos + cnt + 1 < len) &&
+                (p_src[pos + cnt] == p_src[pos + cnt + 1])))
+            {
+                cnt++;
+            }
+
+            if (p_dst != NULL)
+            {
+                p_dst[out] = (uint8_t)(cnt - 1);
+                memcpy(p_dst + out + 1, p_src + pos, cnt);
+            }
+            out = (uint16_t)(out + 1 + cnt);
+        }
+
+        pos = (uint16_t)(pos + cnt);
+    }
+
+    return out;
+}
+
+static void
+rle_decode(const uint8_t *p_src, uint8_t *p_dst, uint16_t len)
+{
+    uint16_t pos = 0;
+    uint16_t cnt;
+    uint8_t ctrl;
+
+    while (pos < len)
+    {
+        ctrl = *p_src++;
+        if (ctrl & RLE_RUN_FLAG)
+        {
+            cnt = (uint16_t)((ctrl & ~RLE_RUN_FLAG) + 2);
+            memset(p_dst + pos, *p_src++, cnt);
+        }
+        else
+        {
+            cnt = (uint16_t)(ctrl + 1);
+            memcpy(p_dst + pos, p_src, cnt);
+            p_src += cnt;
+        }
+
+        pos = (uint16_t)(pos + cnt);
+    }
+}
+
+/* [] END OF FILE */
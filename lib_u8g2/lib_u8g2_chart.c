@@ -0,0 +1,185 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_chart.c
+* @version 1.0.0
+*
+* @brief Scrolling sparkline charts of live samples.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <lib_u8g2_chart.h>
+#include <lib_u8g2_span.h>
+#include <lib_u8g2_dirty.h>
+#include <lib_u8g2_region.h>
+#include <lib_u8g2_scroll.h>
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static uint8_t
+is_supported(u8g2_t *u8g2, const lib_u8g2_chart_t *p_chart);
+
+static int16_t
+sample(const lib_u8g2_chart_t *p_chart, uint16_t index);
+
+static int16_t
+value_row(const lib_u8g2_chart_t *p_chart, int16_t value);
+
+static void
+draw_column(u8g2_t *u8g2, const lib_u8g2_chart_t *p_chart, uint16_t index);
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void
+lib_u8g2_ChartInit(lib_u8g2_chart_t *p_chart, int16_t *p_samples, int16_t x,
+    int16_t y, int16_t w, int16_t h, int16_t min, int16_t max,
+    lib_u8g2_chart_style_t style, uint8_t is_hw_scroll)
+{
+    p_chart->p_samples = p_samples;
+    p_chart->count = 0;
+    p_chart->next = 0;
+    p_chart->x = x;
+    p_chart->y = y;
+    p_chart->w = w;
+    p_chart->h = h;
+    p_chart->min = min;
+    p_chart->max = (max > min) ? max : (int16_t)(min + 1);
+    p_chart->style = style;
+    p_chart->is_hw_scroll = is_hw_scroll;
+}
+
+uint8_t
+lib_u8g2_ChartDraw(u8g2_t *u8g2, lib_u8g2_chart_t *p_chart)
+{
+    if (!is_supported(u8g2, p_chart))
+    {
+        return 0;
+    }
+
+    lib_u8g2_ClearRegion(u8g2, p_chart->x, p_chart->y, p_chart->w,
+        p_chart->h);
+    for (uint16_t i = 0; i < p_chart->count; i++)
+    {
+        draw_column(u8g2, p_chart, i);
+    }
+
+    lib_u8g2_MarkDirty(u8g2, p_chart->x, p_chart->y,
+        (int16_t)(p_chart->x + p_chart->w),
+        (int16_t)(p_chart->y + p_chart->h));
+
+    return 1;
+}
+
+uint8_t
+lib_u8g2_ChartPush(u8g2_t *u8g2, lib_u8g2_chart_t *p_chart, int16_t value)
+{
+    if (!is_supported(u8g2, p_chart))
+    {
+        return 0;
+    }
+
+    p_chart->p_samples[p_chart->next] = value;
+    p_chart->next = (uint16_t)((p_chart->next + 1) % p_chart->w);
+    if (p_chart->count < p_chart->w)
+    {
+        p_chart->count++;
+    }
+
+    if (p_chart->is_hw_scroll)
+    {
+        // Display and frame buffer columns move together, exposed column
+        // is sent after it is drawn
+        lib_u8g2_ScrollWindow(u8g2, 1, p_chart->x,
+            (int16_t)(p_chart->x + p_chart->w), (uint8_t)(p_chart->y / 8),
+            (uint8_t)((p_chart->y + p_chart->h) / 8 - 1));
+        draw_column(u8g2, p_chart, (uint16_t)(p_chart->count - 1));
+        lib_u8g2_SendScrolled(u8g2);
+    }
+    else
+    {
+        lib_u8g2_ScrollRegion(u8g2, p_chart->x, p_chart->y, p_chart->w,
+            p_chart->h, -1, 0);
+        draw_column(u8g2, p_chart, (uint16_t)(p_chart->count - 1));
+        lib_u8g2_MarkDirty(u8g2, p_chart->x, p_chart->y,
+            (int16_t)(p_chart->x + p_chart->w),
+            (int16_t)(p_chart->y + p_chart->h));
+    }
+
+    return 1;
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static uint8_t
+is_supported(u8g2_t *u8g2, const lib_u8g2_chart_t *p_chart)
+{
+    return (uint8_t)(lib_u8g2_IsSpanBuffer(u8g2) &&
+        (u8g2->tile_buf_height == u8x8_GetRows(u8g2_GetU8x8(u8g2))) &&
+        (p_chart->w > 0) && (p_chart->h > 0) && (p_chart->x >= 0) &&
+        (p_chart->y >= 0) && ((p_chart->y & 7) == 0) &&
+        ((p_chart->h & 7) == 0) &&
+        (p_chart->x + p_chart->w <= (int16_t)u8g2->pixel_buf_width) &&
+        (p_chart->y + p_chart->h <= (int16_t)(u8g2->tile_buf_height * 8)));
+}
+
+static int16_t
+sample(const lib_u8g2_chart_t *p_chart, uint16_t index)
+{
+    // Index 0 is the oldest stored sample
+    return p_chart->p_samples[(p_chart->next + p_chart->w - p_chart->count +
+        index) % p_chart->w];
+}
+
+static int16_t
+value_row(const lib_u8g2_chart_t *p_chart, int16_t value)
+{
+    value = (value < p_chart->min) ? p_chart->min : value;
+    value = (value > p_chart->max) ? p_chart->max : value;
+
+    return (int16_t)(((int32_t)p_chart->max - value) * (p_chart->h - 1) /
+        ((int32_t)p_chart->max - p_chart->min));
+}
+
+static void
+draw_column(u8g2_t *u8g2, const lib_u8g2_chart_t *p_chart, uint16_t index)
+{
+    int16_t row0 = value_row(p_chart, sample(p_chart, index));
+    int16_t row1 = row0;
+    int16_t prev;
+    int16_t top;
+    uint8_t *p;
+
+    if (p_chart->style == LIB_U8G2_CHART_BAR)
+    {
+        row1 = (int16_t)(p_chart->h - 1);
+    }
+    else if (index > 0)
+    {
+        // Vertical segment towards previous sample keeps line connected
+        prev = value_row(p_chart, sample(p_chart, (uint16_t)(index - 1)));
+        row0 = (prev < row0) ? (int16_t)(prev + 1) : row0;
+        row1 = (prev > row1) ? (int16_t)(prev - 1) : row1;
+        row1 = (row1 < row0) ? row0 : row1;
+    }
+
+    // Column of chart, rows row0 to row1 are set page by page
+    p = u8g2->tile_buf_ptr + (p_chart->y / 8) * u8g2->pixel_buf_width +
+        p_chart->x + p_chart->w - p_chart->count + index;
+    for (top = 0; top < p_chart->h; top = (int16_t)(top + 8))
+    {
+        if ((row1 >= top) && (row0 < top + 8))
+        {
+            *p |= (uint8_t)((0xFFu << ((row0 > top) ? row0 - top : 0)) &
+                (0xFFu >> ((row1 < top + 7) ? top + 7 - row1 : 0)));
+        }
+        p += u8g2->pixel_buf_width;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,424 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_circle.c
+* @version 1.0.0
+*
+* @brief Span based circle, ellipse and rounded box rasteriser.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <lib_u8g2_circle.h>
+#include <lib_u8g2_span.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+#define SHAPE_NONE              (0)
+#define SHAPE_CIRCLE            (1)
+#define SHAPE_ELLIPSE           (2)
+
+/*******************************************************************************
+* Private types
+*******************************************************************************/
+
+// Per column extents of one quadrant, column index is distance from center
+typedef struct
+{
+    uint8_t kind;
+    u8g2_uint_t rx;
+    u8g2_uint_t ry;
+    uint8_t fill[LIB_U8G2_CIRCLE_MAX_RADIUS + 1];   // Filled shape extent
+    uint8_t lo[LIB_U8G2_CIRCLE_MAX_RADIUS + 1];     // Outline span start
+    uint8_t hi[LIB_U8G2_CIRCLE_MAX_RADIUS + 1];     // Outline span end
+} shape_table_t;
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static const shape_table_t *
+circle_table(u8g2_uint_t rad);
+
+static const shape_table_t *
+ellipse_table(u8g2_uint_t rx, u8g2_uint_t ry);
+
+static void
+draw_column(u8g2_t *u8g2, int16_t x, int16_t y0, uint8_t lo, uint8_t hi,
+    uint8_t upper, uint8_t lower);
+
+static void
+draw_quadrants(u8g2_t *u8g2, int16_t x0, int16_t y0, u8g2_uint_t n,
+    const uint8_t *lo, const uint8_t *hi, uint8_t option);
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+
+static shape_table_t g_shape;   // Tables of last used shape
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void
+lib_u8g2_DrawDisc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0,
+    u8g2_uint_t rad, uint8_t option)
+{
+    const shape_table_t *p_table;
+
+    if (rad > LIB_U8G2_CIRCLE_MAX_RADIUS)
+    {
+        u8g2_DrawDisc(u8g2, x0, y0, rad, option);
+        return;
+    }
+
+    p_table = circle_table(rad);
+
+    // Filled quadrants start at center row, lo is zero
+    draw_quadrants(u8g2, (int16_t)x0, (int16_t)y0, rad, NULL, p_table->fill,
+        option);
+}
+
+void
+lib_u8g2_DrawCircle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0,
+    u8g2_uint_t rad, uint8_t option)
+{
+    const shape_table_t *p_table;
+
+    if (rad > LIB_U8G2_CIRCLE_MAX_RADIUS)
+    {
+        u8g2_DrawCircle(u8g2, x0, y0, rad, option);
+        return;
+    }
+
+    p_table = circle_table(rad);
+    draw_quadrants(u8g2, (int16_t)x0, (int16_t)y0, rad, p_table->lo,
+        p_table->hi, option);
+}
+
+void
+lib_u8g2_DrawFilledEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0,
+    u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option)
+{
+    const shape_table_t *p_table;
+
+    if ((rx > LIB_U8G2_CIRCLE_MAX_RADIUS) || (ry > LIB_U8G2_CIRCLE_MAX_RADIUS))
+    {
+        u8g2_DrawFilledEllipse(u8g2, x0, y0, rx, ry, option);
+        return;
+    }
+
+    p_table = ellipse_table(rx, ry);
+    draw_quadrants(u8g2, (int16_t)x0, (int16_t)y0, rx, NULL, p_table->fill,
+        option);
+}
+
+void
+lib_u8g2_DrawEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0,
+    u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option)
+{
+    const shape_table_t *p_table;
+
+    if ((rx > LIB_U8G2_CIRCLE_MAX_RADIUS) || (ry > LIB_U8G2_CIRCLE_MAX_RADIUS))
+    {
+        u8g2_DrawEllipse(u8g2, x0, y0, rx, ry, option);
+        return;
+    }
+
+    p_table = ellipse_table(rx, ry);
+    draw_quadrants(u8g2, (int16_t)x0, (int16_t)y0, rx, p_table->lo,
+        p_table->hi, option);
+}
+
+void
+lib_u8g2_DrawRBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    u8g2_uint_t w, u8g2_uint_t h, u8g2_uint_t r)
+{
+    const shape_table_t *p_table;
+    int16_t xl;
+    int16_t xr;
+    int16_t yu;
+    int16_t yl;
+    int16_t d;
+
+    if ((w < 2) || (h < 2))
+    {
+        lib_u8g2_DrawBox(u8g2, x, y, w, h);
+        return;
+    }
+
+    // Corner discs must not overlap
+    if (2 * (r + 1) > w)
+    {
+        r = (u8g2_uint_t)(w / 2 - 1);
+    }
+    if (2 * (r + 1) > h)
+    {
+        r = (u8g2_uint_t)(h / 2 - 1);
+    }
+    if (r > LIB_U8G2_CIRCLE_MAX_RADIUS)
+    {
+        u8g2_DrawRBox(u8g2, x, y, w, h, r);
+        return;
+    }
+
+    p_table = circle_table(r);
+
+    // Corner disc centers
+    xl = (int16_t)(x + r);
+    yu = (int16_t)(y + r);
+    xr = (int16_t)(x + w - r - 1);
+    yl = (int16_t)(y + h - r - 1);
+
+    for (int16_t xc = (int16_t)x; xc < (int16_t)(x + w); xc++)
+    {
+        d = (xc < xl) ? (int16_t)(xl - xc) :
+            ((xc > xr) ? (int16_t)(xc - xr) : 0);
+
+        lib_u8g2_FillArea(u8g2, xc, (int16_t)(yu - p_table->fill[d]),
+            (int16_t)(xc + 1), (int16_t)(yl + p_table->fill[d] + 1));
+    }
+}
+
+void
+lib_u8g2_DrawRFrame(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    u8g2_uint_t w, u8g2_uint_t h, u8g2_uint_t r)
+{
+    const shape_table_t *p_table;
+    int16_t xl;
+    int16_t xr;
+    int16_t yu;
+    int16_t yl;
+    int16_t d;
+
+    if ((w < 2) || (h < 2))
+    {
+        lib_u8g2_DrawFrame(u8g2, x, y, w, h);
+        return;
+    }
+
+    if (2 * (r + 1) > w)
+    {
+        r = (u8g2_uint_t)(w / 2 - 1);
+    }
+    if (2 * (r + 1) > h)
+    {
+        r = (u8g2_uint_t)(h / 2 - 1);
+    }
+    if (r > LIB_U8G2_CIRCLE_MAX_RADIUS)
+    {
+        u8g2_DrawRFrame(u8g2, x, y, w, h, r);
+        return;
+    }
+
+    p_table = circle_table(r);
+
+    xl = (int16_t)(x + r);
+    yu = (int16_t)(y + r);
+    xr = (int16_t)(x + w - r - 1);
+    yl = (int16_t)(y + h - r - 1);
+
+    for (int16_t xc = (int16_t)x; xc < (int16_t)(x + w); xc++)
+    {
+        d = (xc < xl) ? (int16_t)(xl - xc) :
+            ((xc > xr) ? (int16_t)(xc - xr) : 0);
+
+        if ((xc == (int16_t)x) || (xc == (int16_t)(x + w - 1)))
+        {
+            // Side edge joins both corner arcs
+            lib_u8g2_FillArea(u8g2, xc, (int16_t)(yu - p_table->hi[d]),
+                (int16_t)(xc + 1), (int16_t)(yl + p_table->hi[d] + 1));
+        }
+        else
+        {
+            lib_u8g2_FillArea(u8g2, xc, (int16_t)(yu - p_table->hi[d]),
+                (int16_t)(xc + 1), (int16_t)(yu - p_table->lo[d] + 1));
+            lib_u8g2_FillArea(u8g2, xc, (int16_t)(yl + p_table->lo[d]),
+                (int16_t)(xc + 1), (int16_t)(yl + p_table->hi[d] + 1));
+        }
+    }
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static const shape_table_t *
+circle_table(u8g2_uint_t rad)
+{
+    shape_table_t *p_table = &g_shape;
+    int16_t f;
+    int16_t ddf_x;
+    int16_t ddf_y;
+    int16_t x;
+    int16_t y;
+
+    if ((p_table->kind == SHAPE_CIRCLE) && (p_table->rx == rad))
+    {
+        return p_table;
+    }
+
+    for (u8g2_uint_t i = 0; i <= rad; i++)
+    {
+        p_table->fill[i] = 0;
+        p_table->lo[i] = 0xFF;
+        p_table->hi[i] = 0;
+    }
+
+    // Same midpoint algorithm as u8g2, each octant point (x, y) puts pixels
+    // to column x at row y and to column y at row x
+    f = (int16_t)(1 - rad);
+    ddf_x = 1;
+    ddf_y = (int16_t)(-2 * rad);
+    x = 0;
+    y = (int16_t)rad;
+
+    for (;;)
+    {
+        if (p_table->fill[x] < y)
+        {
+            p_table->fill[x] = (uint8_t)y;
+        }
+        if (p_table->fill[y] < x)
+        {
+            p_table->fill[y] = (uint8_t)x;
+        }
+
+        if (p_table->lo[x] > y)
+        {
+            p_table->lo[x] = (uint8_t)y;
+        }
+        if (p_table->hi[x] < y)
+        {
+            p_table->hi[x] = (uint8_t)y;
+        }
+        if (p_table->lo[y] > x)
+        {
+            p_table->lo[y] = (uint8_t)x;
+        }
+        if (p_table->hi[y] < x)
+        {
+            p_table->hi[y] = (uint8_t)x;
+        }
+
+        if (x >= y)
+        {
+            break;
+        }
+
+        if (f >= 0)
+        {
+            y--;
+            ddf_y = (int16_t)(ddf_y + 2);
+            f = (int16_t)(f + ddf_y);
+        }
+        x++;
+        ddf_x = (int16_t)(ddf_x + 2);
+        f = (int16_t)(f + ddf_x);
+    }
+
+    p_table->kind = SHAPE_CIRCLE;
+    p_table->rx = rad;
+    p_table->ry = rad;
+
+    return p_table;
+}
+
+static const shape_table_t *
+ellipse_table(u8g2_uint_t rx, u8g2_uint_t ry)
+{
+    shape_table_t *p_table = &g_shape;
+    int32_t rx2 = (int32_t)rx * rx;
+    int32_t ry2 = (int32_t)ry * ry;
+    int64_t limit = (int64_t)rx2 * ry2;
+    int16_t h = (int16_t)ry;
+
+    if ((p_table->kind == SHAPE_ELLIPSE) && (p_table->rx == rx) &&
+        (p_table->ry == ry))
+    {
+        return p_table;
+    }
+
+    // Largest h with (c / rx)^2 + (h / ry)^2 <= 1, h decreases with c
+    for (u8g2_uint_t c = 0; c <= rx; c++)
+    {
+        while ((h > 0) &&
+            ((int64_t)c * c * ry2 + (int64_t)h * h * rx2 > limit))
+        {
+            h--;
+        }
+        p_table->fill[c] = (uint8_t)h;
+    }
+
+    // Outline column covers rows down to the next column extent
+    for (u8g2_uint_t c = 0; c <= rx; c++)
+    {
+        p_table->hi[c] = p_table->fill[c];
+        if ((c < rx) && (p_table->fill[c + 1] < p_table->fill[c]))
+        {
+            p_table->lo[c] = (uint8_t)(p_table->fill[c + 1] + 1);
+        }
+        else
+        {
+            p_table->lo[c] = (c < rx) ? p_table->fill[c] : 0;
+        }
+    }
+
+    p_table->kind = SHAPE_ELLIPSE;
+    p_table->rx = rx;
+    p_table->ry = ry;
+
+    return p_table;
+}
+
+static void
+draw_column(u8g2_t *u8g2, int16_t x, int16_t y0, uint8_t lo, uint8_t hi,
+    uint8_t upper, uint8_t lower)
+{
+    if (upper && lower && (lo == 0))
+    {
+        // Single span through center row
+        lib_u8g2_FillArea(u8g2, x, (int16_t)(y0 - hi), (int16_t)(x + 1),
+            (int16_t)(y0 + hi + 1));
+        return;
+    }
+
+    if (upper)
+    {
+        lib_u8g2_FillArea(u8g2, x, (int16_t)(y0 - hi), (int16_t)(x + 1),
+            (int16_t)(y0 - lo + 1));
+    }
+    if (lower)
+    {
+        lib_u8g2_FillArea(u8g2, x, (int16_t)(y0 + lo), (int16_t)(x + 1),
+            (int16_t)(y0 + hi + 1));
+    }
+}
+
+static void
+draw_quadrants(u8g2_t *u8g2, int16_t x0, int16_t y0, u8g2_uint_t n,
+    const uint8_t *lo, const uint8_t *hi, uint8_t option)
+{
+    uint8_t lo_c;
+
+    // Center column is shared by left and right quadrants
+    draw_column(u8g2, x0, y0, (lo != NULL) ? lo[0] : 0, hi[0],
+        (option & (U8G2_DRAW_UPPER_RIGHT | U8G2_DRAW_UPPER_LEFT)) != 0,
+        (option & (U8G2_DRAW_LOWER_RIGHT | U8G2_DRAW_LOWER_LEFT)) != 0);
+
+    for (u8g2_uint_t c = 1; c <= n; c++)
+    {
+        lo_c = (lo != NULL) ? lo[c] : 0;
+
+        draw_column(u8g2, (int16_t)(x0 + c), y0, lo_c, hi[c],
+            (option & U8G2_DRAW_UPPER_RIGHT) != 0,
+            (option & U8G2_DRAW_LOWER_RIGHT) != 0);
+        draw_column(u8g2, (int16_t)(x0 - c), y0, lo_c, hi[c],
+            (option & U8G2_DRAW_UPPER_LEFT) != 0,
+            (option & U8G2_DRAW_LOWER_LEFT) != 0);
+    }
+}
+
+/* [] END OF FILE */
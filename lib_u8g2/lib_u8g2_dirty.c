@@ -0,0 +1,347 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_dirty.c
+* @version 1.0.0
+*
+* @brief Automatic dirty area tracking of draw calls.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <string.h>
+
+#include <lib_u8g2_dirty.h>
+#include <lib_u8g2_scroll.h>
+
+/*******************************************************************************
+* Private types
+*******************************************************************************/
+
+typedef struct
+{
+    int16_t x0;     // Half-open ranges, empty if x0 >= x1
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+} area_t;
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static void
+area_add(area_t *p_area, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+#if LIB_U8G2_DIRTY_COMPARE
+static void
+send_changed(u8g2_t *u8g2, uint8_t tx0, uint8_t ty0, uint8_t tx1,
+    uint8_t ty1);
+#endif
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+
+static u8g2_draw_ll_hvline_cb g_ll_hvline;  // Wrapped callback
+static area_t g_dirty;      // Changed since last send
+static area_t g_content;    // Drawn since last clear
+static uint8_t g_is_paused;
+
+#if LIB_U8G2_DIRTY_COMPARE
+static uint8_t g_shadow[LIB_U8G2_DIRTY_SHADOW_SIZE];   // Last sent content
+static uint8_t g_is_shadow_valid;
+#endif
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void
+lib_u8g2_SetDirtyTracking(u8g2_t *u8g2)
+{
+    if (u8g2->ll_hvline != lib_u8g2_dirty_ll_hvline)
+    {
+        g_ll_hvline = u8g2->ll_hvline;
+        u8g2->ll_hvline = lib_u8g2_dirty_ll_hvline;
+    }
+
+    lib_u8g2_InvalidateDirty(u8g2);
+}
+
+void
+lib_u8g2_dirty_ll_hvline(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    u8g2_uint_t len, uint8_t dir)
+{
+    // Coordinates are relative to current buffer page
+    int16_t y0 = (int16_t)(y + u8g2->pixel_curr_row);
+
+    if (dir == 0)
+    {
+        lib_u8g2_MarkDirty(u8g2, (int16_t)x, y0, (int16_t)(x + len),
+            (int16_t)(y0 + 1));
+    }
+    else
+    {
+        lib_u8g2_MarkDirty(u8g2, (int16_t)x, y0, (int16_t)(x + 1),
+            (int16_t)(y0 + len));
+    }
+
+    g_ll_hvline(u8g2, x, y, len, dir);
+}
+
+u8g2_draw_ll_hvline_cb
+lib_u8g2_GetTrackedHvline(void)
+{
+    return g_ll_hvline;
+}
+
+void
+lib_u8g2_MarkDirty(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1,
+    int16_t y1)
+{
+    if ((g_ll_hvline == NULL) || g_is_paused)
+    {
+        return;
+    }
+
+    area_add(&g_dirty, x0, y0, x1, y1);
+    area_add(&g_content, x0, y0, x1, y1);
+}
+
+void
+lib_u8g2_PauseDirty(uint8_t is_paused)
+{
+    g_is_paused = is_paused;
+}
+
+uint8_t
+lib_u8g2_GetDirtyArea(u8g2_t *u8g2, int16_t *p_x0, int16_t *p_y0,
+    int16_t *p_x1, int16_t *p_y1)
+{
+    int16_t width = (int16_t)u8g2_GetDisplayWidth(u8g2);
+    int16_t height = (int16_t)u8g2_GetDisplayHeight(u8g2);
+
+    if (g_ll_hvline == NULL)
+    {
+        *p_x0 = 0;
+        *p_y0 = 0;
+        *p_x1 = width;
+        *p_y1 = height;
+        return 1;
+    }
+
+    *p_x0 = (g_dirty.x0 < 0) ? 0 : g_dirty.x0;
+    *p_y0 = (g_dirty.y0 < 0) ? 0 : g_dirty.y0;
+    *p_x1 = (g_dirty.x1 > width) ? width : g_dirty.x1;
+    *p_y1 = (g_dirty.y1 > height) ? height : g_dirty.y1;
+
+    return (uint8_t)((*p_x0 < *p_x1) && (*p_y0 < *p_y1));
+}
+
+void
+lib_u8g2_InvalidateDirty(u8g2_t *u8g2)
+{
+    g_dirty.x0 = 0;
+    g_dirty.y0 = 0;
+    g_dirty.x1 = (int16_t)u8g2_GetDisplayWidth(u8g2);
+    g_dirty.y1 = (int16_t)u8g2_GetDisplayHeight(u8g2);
+
+    // Display content is unknown
+    g_content = g_dirty;
+
+#if LIB_U8G2_DIRTY_COMPARE
+    g_is_shadow_valid = 0;
+#endif
+}
+
+void
+lib_u8g2_MarkClean(u8g2_t *u8g2)
+{
+    g_dirty.x1 = g_dirty.x0;
+
+#if LIB_U8G2_DIRTY_COMPARE
+    // Display shows frame buffer content, shadow can take it over
+    if ((lib_u8g2_GetStartLine() == 0) &&
+        ((size_t)u8g2->tile_buf_height * u8g2->pixel_buf_width <=
+        sizeof(g_shadow)))
+    {
+        memcpy(g_shadow, u8g2->tile_buf_ptr,
+            (size_t)u8g2->tile_buf_height * u8g2->pixel_buf_width);
+        g_is_shadow_valid = 1;
+    }
+#endif
+}
+
+void
+lib_u8g2_ClearBuffer(u8g2_t *u8g2)
+{
+    u8g2_ClearBuffer(u8g2);
+
+    // Everything drawn since previous clear is erased
+    if (!g_is_paused && (g_content.x0 < g_content.x1))
+    {
+        area_add(&g_dirty, g_content.x0, g_content.y0, g_content.x1,
+            g_content.y1);
+        g_content.x1 = g_content.x0;
+    }
+}
+
+uint8_t
+lib_u8g2_SendDirty(u8g2_t *u8g2)
+{
+    int16_t width = (int16_t)u8g2_GetDisplayWidth(u8g2);
+    int16_t height = (int16_t)u8g2_GetDisplayHeight(u8g2);
+    uint8_t tx0;
+    uint8_t ty0;
+    uint8_t tx1;
+    uint8_t ty1;
+
+    if (g_ll_hvline == NULL)
+    {
+        u8g2_SendBuffer(u8g2);
+        return 1;
+    }
+
+    if (g_dirty.x0 < 0)
+    {
+        g_dirty.x0 = 0;
+    }
+    if (g_dirty.y0 < 0)
+    {
+        g_dirty.y0 = 0;
+    }
+    if (g_dirty.x1 > width)
+    {
+        g_dirty.x1 = width;
+    }
+    if (g_dirty.y1 > height)
+    {
+        g_dirty.y1 = height;
+    }
+    if ((g_dirty.x0 >= g_dirty.x1) || (g_dirty.y0 >= g_dirty.y1))
+    {
+        g_dirty.x1 = g_dirty.x0;
+        return 0;
+    }
+
+    // Tile aligned bounding box
+    tx0 = (uint8_t)(g_dirty.x0 / 8);
+    ty0 = (uint8_t)(g_dirty.y0 / 8);
+    tx1 = (uint8_t)((g_dirty.x1 + 7) / 8);
+    ty1 = (uint8_t)((g_dirty.y1 + 7) / 8);
+    g_dirty.x1 = g_dirty.x0;
+
+    if (lib_u8g2_GetStartLine() != 0)
+    {
+        // Display RAM pages are rotated by hardware scrolling
+        lib_u8g2_ScrollSendArea(u8g2, (int16_t)(tx0 * 8), (int16_t)(ty0 * 8),
+            (int16_t)(tx1 * 8), (int16_t)(ty1 * 8));
+#if LIB_U8G2_DIRTY_COMPARE
+        g_is_shadow_valid = 0;
+#endif
+        return 1;
+    }
+
+#if LIB_U8G2_DIRTY_COMPARE
+    if ((size_t)u8g2->tile_buf_height * u8g2->pixel_buf_width <=
+        sizeof(g_shadow))
+    {
+        send_changed(u8g2, tx0, ty0, tx1, ty1);
+        return 1;
+    }
+#endif
+
+    u8g2_UpdateDisplayArea(u8g2, tx0, ty0, (uint8_t)(tx1 - tx0),
+        (uint8_t)(ty1 - ty0));
+
+    return 1;
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static void
+area_add(area_t *p_area, int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    if ((x0 >= x1) || (y0 >= y1))
+    {
+        return;
+    }
+
+    if (p_area->x0 >= p_area->x1)
+    {
+        p_area->x0 = x0;
+        p_area->y0 = y0;
+        p_area->x1 = x1;
+        p_area->y1 = y1;
+        return;
+    }
+
+    if (x0 < p_area->x0)
+    {
+        p_area->x0 = x0;
+    }
+    if (y0 < p_area->y0)
+    {
+        p_area->y0 = y0;
+    }
+    if (x1 > p_area->x1)
+    {
+        p_area->x1 = x1;
+    }
+    if (y1 > p_area->y1)
+    {
+        p_area->y1 = y1;
+    }
+}
+
+#if LIB_U8G2_DIRTY_COMPARE
+static void
+send_changed(u8g2_t *u8g2, uint8_t tx0, uint8_t ty0, uint8_t tx1,
+    uint8_t ty1)
+{
+    size_t offset;
+    int16_t first;
+    int16_t last;
+
+    for (uint8_t ty = ty0; ty < ty1; ty++)
+    {
+        // First and last changed tile of tile row
+        first = -1;
+        last = -1;
+        for (uint8_t tx = tx0; tx < tx1; tx++)
+        {
+            offset = (size_t)ty * u8g2->pixel_buf_width + (size_t)tx * 8;
+            if (!g_is_shadow_valid ||
+                (memcmp(&g_shadow[offset], &u8g2->tile_buf_ptr[offset], 8) != 0))
+            {
+                if (first < 0)
+                {
+                    first = tx;
+                }
+                last = tx;
+            }
+        }
+
+        if (first >= 0)
+        {
+            u8g2_UpdateDisplayArea(u8g2, (uint8_t)first, ty,
+                (uint8_t)(last - first + 1), 1);
+            offset = (size_t)ty * u8g2->pixel_buf_width + (size_t)first * 8;
+            memcpy(&g_shadow[offset], &u8g2->tile_buf_ptr[offset],
+                (size_t)(last - first + 1) * 8);
+        }
+    }
+
+    // Shadow holds whole display after whole display was sent
+    if ((tx0 == 0) && (ty0 == 0) &&
+        (tx1 == u8g2_GetBufferTileWidth(u8g2)) &&
+        (ty1 == u8g2->tile_buf_height))
+    {
+        g_is_shadow_valid = 1;
+    }
+}
+#endif
+
+/* [] END OF FILE */
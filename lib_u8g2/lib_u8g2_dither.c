@@ -0,0 +1,257 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_dither.c
+* @version 1.0.0
+*
+* @brief Grayscale images dithered into frame buffer.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <string.h>
+
+#include <lib_u8g2_dither.h>
+#include <lib_u8g2_span.h>
+#include <lib_u8g2_dirty.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+// Error rows hold sums of error times weight in 1/16, padded by 2 columns
+// on both sides so that neighbours need no bounds checks
+#define ERR_PAD                 (2)
+#define ERR_ROW_LEN             (LIB_U8G2_DITHER_MAX_WIDTH + 2 * ERR_PAD)
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static void
+bayer_row(const uint8_t *p_row, uint16_t w, int16_t x, int16_t y);
+
+static void
+floyd_steinberg_row(const uint8_t *p_row, uint16_t w);
+
+static void
+atkinson_row(const uint8_t *p_row, uint16_t w);
+
+static void
+rotate_err_rows(void);
+
+static void
+write_row(u8g2_t *u8g2, int16_t x, int16_t y, uint16_t i0, uint16_t i1);
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+
+// 8x8 Bayer index matrix, threshold is index * 4 + 2
+static const uint8_t g_bayer[8][8] = {
+    {  0, 32,  8, 40,  2, 34, 10, 42 },
+    { 48, 16, 56, 24, 50, 18, 58, 26 },
+    { 12, 44,  4, 36, 14, 46,  6, 38 },
+    { 60, 28, 52, 20, 62, 30, 54, 22 },
+    {  3, 35, 11, 43,  1, 33,  9, 41 },
+    { 51, 19, 59, 27, 49, 17, 57, 25 },
+    { 15, 47,  7, 39, 13, 45,  5, 37 },
+    { 63, 31, 55, 23, 61, 29, 53, 21 }
+};
+
+static int16_t g_err[3][ERR_ROW_LEN];
+static int16_t *g_p_err0;   // Current row
+static int16_t *g_p_err1;   // Next row
+static int16_t *g_p_err2;   // Row after next
+static uint8_t g_out[LIB_U8G2_DITHER_MAX_WIDTH];   // 0x00 dark, 0xFF lit
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+uint8_t
+lib_u8g2_DitherImage(u8g2_t *u8g2, int16_t x, int16_t y, uint16_t w,
+    uint16_t h, lib_u8g2_dither_t method, lib_u8g2_row_source_cb source,
+    void *p_ctx)
+{
+    int16_t width = (int16_t)u8g2->pixel_buf_width;
+    int16_t height = (int16_t)(u8g2->tile_buf_height * 8);
+    int32_t right = (int32_t)x + w;
+    uint16_t i0;
+    uint16_t i1;
+    const uint8_t *p_row;
+    int16_t py;
+
+    if (!lib_u8g2_IsSpanBuffer(u8g2) ||
+        (u8g2->tile_buf_height != u8x8_GetRows(u8g2_GetU8x8(u8g2))) ||
+        (w > LIB_U8G2_DITHER_MAX_WIDTH))
+    {
+        return 0;
+    }
+
+    if ((x >= width) || (right <= 0))
+    {
+        // Image is outside display, nothing to draw
+        return 1;
+    }
+
+    // Image columns i0 to i1 are visible
+    i0 = (uint16_t)((x < 0) ? -(int32_t)x : 0);
+    i1 = (uint16_t)((right > width) ? (int32_t)width - x : (int32_t)w);
+
+    memset(g_err, 0, sizeof(g_err));
+    g_p_err0 = g_err[0] + ERR_PAD;
+    g_p_err1 = g_err[1] + ERR_PAD;
+    g_p_err2 = g_err[2] + ERR_PAD;
+
+    for (uint16_t row = 0; row < h; row++)
+    {
+        py = (int16_t)(y + row);
+        if (py >= height)
+        {
+            break;
+        }
+        if ((method == LIB_U8G2_DITHER_BAYER) && (py < 0))
+        {
+            // Ordered dithering needs no rows above display
+            continue;
+        }
+
+        p_row = source(p_ctx, row);
+        if (p_row == NULL)
+        {
+            return 0;
+        }
+
+        switch (method)
+        {
+            case LIB_U8G2_DITHER_FLOYD_STEINBERG:
+                floyd_steinberg_row(p_row, w);
+                break;
+
+            case LIB_U8G2_DITHER_ATKINSON:
+                atkinson_row(p_row, w);
+                break;
+
+            default:
+                bayer_row(p_row, w, x, py);
+                break;
+        }
+
+        if ((py >= 0) && (i0 < i1))
+        {
+            write_row(u8g2, (int16_t)(x + i0), py, i0, i1);
+        }
+    }
+
+    if (i0 < i1)
+    {
+        lib_u8g2_MarkDirty(u8g2, (int16_t)(x + i0), y, (int16_t)(x + i1),
+            (int16_t)(y + h));
+    }
+
+    return 1;
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static void
+bayer_row(const uint8_t *p_row, uint16_t w, int16_t x, int16_t y)
+{
+    const uint8_t *p_index = g_bayer[y & 7];
+    uint8_t thr[8];
+
+    // Thresholds rotated to image columns, pattern is anchored to display
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        thr[i] = (uint8_t)(p_index[(x + i) & 7] * 4 + 2);
+    }
+
+    // Branchless compare, compiler vectorises the loop where available
+    for (uint16_t i = 0; i < w; i++)
+    {
+        g_out[i] = (uint8_t)(0u - (uint8_t)(p_row[i] > thr[i & 7]));
+    }
+}
+
+static void
+floyd_steinberg_row(const uint8_t *p_row, uint16_t w)
+{
+    int16_t *p_e0 = g_p_err0;
+    int16_t *p_e1 = g_p_err1;
+    int16_t level;
+    int16_t err;
+
+    for (uint16_t i = 0; i < w; i++)
+    {
+        level = (int16_t)(p_row[i] + ((p_e0[i] + 8) >> 4));
+        g_out[i] = (uint8_t)((level >= 128) ? 0xFF : 0x00);
+        err = (int16_t)((level >= 128) ? level - 255 : level);
+
+        // Weights 7/16 right, 3/16, 5/16 and 1/16 below
+        p_e0[i + 1] = (int16_t)(p_e0[i + 1] + err * 7);
+        p_e1[i - 1] = (int16_t)(p_e1[i - 1] + err * 3);
+        p_e1[i] = (int16_t)(p_e1[i] + err * 5);
+        p_e1[i + 1] = (int16_t)(p_e1[i + 1] + err);
+    }
+
+    rotate_err_rows();
+}
+
+static void
+atkinson_row(const uint8_t *p_row, uint16_t w)
+{
+    int16_t *p_e0 = g_p_err0;
+    int16_t *p_e1 = g_p_err1;
+    int16_t *p_e2 = g_p_err2;
+    int16_t level;
+    int16_t err;
+
+    for (uint16_t i = 0; i < w; i++)
+    {
+        level = (int16_t)(p_row[i] + ((p_e0[i] + 8) >> 4));
+        g_out[i] = (uint8_t)((level >= 128) ? 0xFF : 0x00);
+        err = (int16_t)((level >= 128) ? level - 255 : level);
+
+        // Weight 1/8 to six neighbours, remaining 1/4 of error is dropped
+        err = (int16_t)(err * 2);
+        p_e0[i + 1] = (int16_t)(p_e0[i + 1] + err);
+        p_e0[i + 2] = (int16_t)(p_e0[i + 2] + err);
+        p_e1[i - 1] = (int16_t)(p_e1[i - 1] + err);
+        p_e1[i] = (int16_t)(p_e1[i] + err);
+        p_e1[i + 1] = (int16_t)(p_e1[i + 1] + err);
+        p_e2[i] = (int16_t)(p_e2[i] + err);
+    }
+
+    rotate_err_rows();
+}
+
+static void
+rotate_err_rows(void)
+{
+    int16_t *p_done = g_p_err0;
+
+    g_p_err0 = g_p_err1;
+    g_p_err1 = g_p_err2;
+    g_p_err2 = p_done;
+    memset(p_done - ERR_PAD, 0, ERR_ROW_LEN * sizeof(int16_t));
+}
+
+static void
+write_row(u8g2_t *u8g2, int16_t x, int16_t y, uint16_t i0, uint16_t i1)
+{
+    uint8_t *p_dst = u8g2->tile_buf_ptr +
+        (y >> 3) * u8g2->pixel_buf_width + x;
+    uint8_t mask = (uint8_t)(1u << (y & 7));
+    uint8_t keep = (uint8_t)~mask;
+    const uint8_t *p_out = g_out + i0;
+    uint16_t cnt = (uint16_t)(i1 - i0);
+
+    for (uint16_t i = 0; i < cnt; i++)
+    {
+        p_dst[i] = (uint8_t)((p_dst[i] & keep) | (p_out[i] & mask));
+    }
+}
+
+/* [] END OF FILE */
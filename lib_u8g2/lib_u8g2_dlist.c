@@ -0,0 +1,463 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_dlist.c
+* @version 1.0.0
+*
+* @brief Display list recording and per page replay.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <string.h>
+
+#include <lib_u8g2_dlist.h>
+#include <lib_u8g2_span.h>
+#include <lib_u8g2_circle.h>
+#include <lib_u8g2_font.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+// Command header: opcode, command length, first row, row after last row
+#define CMD_HEADER_SIZE         (6)
+#define CMD_MAX_SIZE            (255)
+#define STR_MAX_LEN             (240)
+
+// u8g2 font header
+#define FONT_MAX_CHAR_HEIGHT    (10)
+#define FONT_Y_OFFSET           (12)
+
+/*******************************************************************************
+* Private types
+*******************************************************************************/
+
+typedef enum
+{
+    // State commands, never culled
+    OP_COLOR,
+    OP_FONT,
+    // Draw commands
+    OP_PIXEL,
+    OP_HLINE,
+    OP_VLINE,
+    OP_LINE,
+    OP_BOX,
+    OP_FRAME,
+    OP_RBOX,
+    OP_RFRAME,
+    OP_DISC,
+    OP_CIRCLE,
+    OP_XBM,
+    OP_GLYPH,
+    OP_STR
+} opcode_t;
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static uint8_t *
+put_cmd(lib_u8g2_dlist_t *p_dl, opcode_t op, int16_t y0, int16_t y1,
+    uint8_t arg_len);
+
+static void
+put_args(lib_u8g2_dlist_t *p_dl, opcode_t op, int16_t y0, int16_t y1,
+    const int16_t *args, uint8_t cnt);
+
+static void
+text_rows(const lib_u8g2_dlist_t *p_dl, int16_t y, int16_t *p_y0,
+    int16_t *p_y1);
+
+static void
+put16(uint8_t *ptr, int16_t value);
+
+static int16_t
+get16(const uint8_t *ptr);
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void
+lib_u8g2_DlInit(lib_u8g2_dlist_t *p_dl, uint8_t *p_buf, uint16_t size)
+{
+    p_dl->p_buf = p_buf;
+    p_dl->size = size;
+    lib_u8g2_DlClear(p_dl);
+}
+
+void
+lib_u8g2_DlClear(lib_u8g2_dlist_t *p_dl)
+{
+    p_dl->len = 0;
+    p_dl->font = NULL;
+    p_dl->is_overflow = 0;
+}
+
+void
+lib_u8g2_DlReplay(u8g2_t *u8g2, const lib_u8g2_dlist_t *p_dl)
+{
+    const uint8_t *ptr = p_dl->p_buf;
+    const uint8_t *p_end = p_dl->p_buf + p_dl->len;
+    const uint8_t *p_arg;
+    const uint8_t *p_data;
+    int16_t page_y0 = (int16_t)u8g2->user_y0;
+    int16_t page_y1 = (int16_t)u8g2->user_y1;
+
+    for (; ptr < p_end; ptr += ptr[1])
+    {
+        // Skip draw commands outside of current page
+        if ((ptr[0] >= OP_PIXEL) &&
+            ((get16(ptr + 4) <= page_y0) || (get16(ptr + 2) >= page_y1)))
+        {
+            continue;
+        }
+
+        p_arg = ptr + CMD_HEADER_SIZE;
+
+        switch (ptr[0])
+        {
+        case OP_COLOR:
+            u8g2_SetDrawColor(u8g2, p_arg[0]);
+            break;
+
+        case OP_FONT:
+            memcpy(&p_data, p_arg, sizeof(p_data));
+            lib_u8g2_SetFont(u8g2, p_data);
+            break;
+
+        case OP_PIXEL:
+            u8g2_DrawPixel(u8g2, (u8g2_uint_t)get16(p_arg),
+                (u8g2_uint_t)get16(p_arg + 2));
+            break;
+
+        case OP_HLINE:
+            lib_u8g2_DrawHSpan(u8g2, (u8g2_uint_t)get16(p_arg),
+                (u8g2_uint_t)get16(p_arg + 2), (u8g2_uint_t)get16(p_arg + 4));
+            break;
+
+        case OP_VLINE:
+            lib_u8g2_DrawVSpan(u8g2, (u8g2_uint_t)get16(p_arg),
+                (u8g2_uint_t)get16(p_arg + 2), (u8g2_uint_t)get16(p_arg + 4));
+            break;
+
+        case OP_LINE:
+            u8g2_DrawLine(u8g2, (u8g2_uint_t)get16(p_arg),
+                (u8g2_uint_t)get16(p_arg + 2), (u8g2_uint_t)get16(p_arg + 4),
+                (u8g2_uint_t)get16(p_arg + 6));
+            break;
+
+        case OP_BOX:
+            lib_u8g2_DrawBox(u8g2, (u8g2_uint_t)get16(p_arg),
+                (u8g2_uint_t)get16(p_arg + 2), (u8g2_uint_t)get16(p_arg + 4),
+                (u8g2_uint_t)get16(p_arg + 6));
+            break;
+
+        case OP_FRAME:
+            lib_u8g2_DrawFrame(u8g2, (u8g2_uint_t)get16(p_arg),
+                (u8g2_uint_t)get16(p_arg + 2), (u8g2_uint_t)get16(p_arg + 4),
+                (u8g2_uint_t)get16(p_arg + 6));
+            break;
+
+        case OP_RBOX:
+            lib_u8g2_DrawRBox(u8g2, (u8g2_uint_t)get16(p_arg),
+                (u8g2_uint_t)get16(p_arg + 2), (u8g2_uint_t)get16(p_arg + 4),
+                (u8g2_uint_t)get16(p_arg + 6), (u8g2_uint_t)get16(p_arg + 8));
+            break;
+
+        case OP_RFRAME:
+            lib_u8g2_DrawRFrame(u8g2, (u8g2_uint_t)get16(p_arg),
+                (u8g2_uint_t)get16(p_arg + 2), (u8g2_uint_t)get16(p_arg + 4),
+                (u8g2_uint_t)get16(p_arg + 6), (u8g2_uint_t)get16(p_arg + 8));
+            break;
+
+        case OP_DISC:
+            lib_u8g2_DrawDisc(u8g2, (u8g2_uint_t)get16(p_arg),
+                (u8g2_uint_t)get16(p_arg + 2), (u8g2_uint_t)get16(p_arg + 4),
+                (uint8_t)get16(p_arg + 6));
+            break;
+
+        case OP_CIRCLE:
+            lib_u8g2_DrawCircle(u8g2, (u8g2_uint_t)get16(p_arg),
+                (u8g2_uint_t)get16(p_arg + 2), (u8g2_uint_t)get16(p_arg + 4),
+                (uint8_t)get16(p_arg + 6));
+            break;
+
+        case OP_XBM:
+            memcpy(&p_data, p_arg + 8, sizeof(p_data));
+            u8g2_DrawXBM(u8g2, (u8g2_uint_t)get16(p_arg),
+                (u8g2_uint_t)get16(p_arg + 2), (u8g2_uint_t)get16(p_arg + 4),
+                (u8g2_uint_t)get16(p_arg + 6), p_data);
+            break;
+
+        case OP_GLYPH:
+            lib_u8g2_DrawGlyph(u8g2, (u8g2_uint_t)get16(p_arg),
+                (u8g2_uint_t)get16(p_arg + 2), (uint16_t)get16(p_arg + 4));
+            break;
+
+        case OP_STR:
+            lib_u8g2_DrawUTF8(u8g2, (u8g2_uint_t)get16(p_arg),
+                (u8g2_uint_t)get16(p_arg + 2), (const char *)(p_arg + 4));
+            break;
+
+        default:
+            break;
+        }
+    }
+}
+
+void
+lib_u8g2_DlSend(u8g2_t *u8g2, const lib_u8g2_dlist_t *p_dl)
+{
+    u8g2_FirstPage(u8g2);
+    do
+    {
+        lib_u8g2_DlReplay(u8g2, p_dl);
+    } while (u8g2_NextPage(u8g2));
+}
+
+void
+lib_u8g2_DlSetDrawColor(lib_u8g2_dlist_t *p_dl, uint8_t color)
+{
+    uint8_t *p_arg = put_cmd(p_dl, OP_COLOR, INT16_MIN, INT16_MAX, 1);
+
+    if (p_arg != NULL)
+    {
+        p_arg[0] = color;
+    }
+}
+
+void
+lib_u8g2_DlSetFont(lib_u8g2_dlist_t *p_dl, const uint8_t *font)
+{
+    uint8_t *p_arg = put_cmd(p_dl, OP_FONT, INT16_MIN, INT16_MAX,
+        (uint8_t)sizeof(font));
+
+    if (p_arg != NULL)
+    {
+        memcpy(p_arg, &font, sizeof(font));
+    }
+    p_dl->font = font;
+}
+
+void
+lib_u8g2_DlDrawPixel(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y)
+{
+    int16_t args[] = { x, y };
+
+    put_args(p_dl, OP_PIXEL, y, (int16_t)(y + 1), args, 2);
+}
+
+void
+lib_u8g2_DlDrawHLine(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    int16_t w)
+{
+    int16_t args[] = { x, y, w };
+
+    put_args(p_dl, OP_HLINE, y, (int16_t)(y + 1), args, 3);
+}
+
+void
+lib_u8g2_DlDrawVLine(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    int16_t h)
+{
+    int16_t args[] = { x, y, h };
+
+    put_args(p_dl, OP_VLINE, y, (int16_t)(y + h), args, 3);
+}
+
+void
+lib_u8g2_DlDrawLine(lib_u8g2_dlist_t *p_dl, int16_t x0, int16_t y0,
+    int16_t x1, int16_t y1)
+{
+    int16_t args[] = { x0, y0, x1, y1 };
+
+    put_args(p_dl, OP_LINE, (y0 < y1) ? y0 : y1,
+        (int16_t)(((y0 < y1) ? y1 : y0) + 1), args, 4);
+}
+
+void
+lib_u8g2_DlDrawBox(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y, int16_t w,
+    int16_t h)
+{
+    int16_t args[] = { x, y, w, h };
+
+    put_args(p_dl, OP_BOX, y, (int16_t)(y + h), args, 4);
+}
+
+void
+lib_u8g2_DlDrawFrame(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    int16_t w, int16_t h)
+{
+    int16_t args[] = { x, y, w, h };
+
+    put_args(p_dl, OP_FRAME, y, (int16_t)(y + h), args, 4);
+}
+
+void
+lib_u8g2_DlDrawRBox(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    int16_t w, int16_t h, int16_t r)
+{
+    int16_t args[] = { x, y, w, h, r };
+
+    put_args(p_dl, OP_RBOX, y, (int16_t)(y + h), args, 5);
+}
+
+void
+lib_u8g2_DlDrawRFrame(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    int16_t w, int16_t h, int16_t r)
+{
+    int16_t args[] = { x, y, w, h, r };
+
+    put_args(p_dl, OP_RFRAME, y, (int16_t)(y + h), args, 5);
+}
+
+void
+lib_u8g2_DlDrawDisc(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    int16_t r, uint8_t option)
+{
+    int16_t args[] = { x, y, r, option };
+
+    put_args(p_dl, OP_DISC, (int16_t)(y - r), (int16_t)(y + r + 1), args, 4);
+}
+
+void
+lib_u8g2_DlDrawCircle(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    int16_t r, uint8_t option)
+{
+    int16_t args[] = { x, y, r, option };
+
+    put_args(p_dl, OP_CIRCLE, (int16_t)(y - r), (int16_t)(y + r + 1), args,
+        4);
+}
+
+void
+lib_u8g2_DlDrawXBM(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y, int16_t w,
+    int16_t h, const uint8_t *bitmap)
+{
+    uint8_t *p_arg = put_cmd(p_dl, OP_XBM, y, (int16_t)(y + h),
+        (uint8_t)(8 + sizeof(bitmap)));
+
+    if (p_arg != NULL)
+    {
+        put16(p_arg, x);
+        put16(p_arg + 2, y);
+        put16(p_arg + 4, w);
+        put16(p_arg + 6, h);
+        memcpy(p_arg + 8, &bitmap, sizeof(bitmap));
+    }
+}
+
+void
+lib_u8g2_DlDrawGlyph(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    uint16_t encoding)
+{
+    int16_t args[] = { x, y, (int16_t)encoding };
+    int16_t y0;
+    int16_t y1;
+
+    text_rows(p_dl, y, &y0, &y1);
+    put_args(p_dl, OP_GLYPH, y0, y1, args, 3);
+}
+
+void
+lib_u8g2_DlDrawUTF8(lib_u8g2_dlist_t *p_dl, int16_t x, int16_t y,
+    const char *s)
+{
+    size_t len = strlen(s);
+    uint8_t *p_arg;
+    int16_t y0;
+    int16_t y1;
+
+    if (len > STR_MAX_LEN)
+    {
+        len = STR_MAX_LEN;
+    }
+
+    text_rows(p_dl, y, &y0, &y1);
+    p_arg = put_cmd(p_dl, OP_STR, y0, y1, (uint8_t)(4 + len + 1));
+    if (p_arg != NULL)
+    {
+        put16(p_arg, x);
+        put16(p_arg + 2, y);
+        memcpy(p_arg + 4, s, len);
+        p_arg[4 + len] = '\0';
+    }
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static uint8_t *
+put_cmd(lib_u8g2_dlist_t *p_dl, opcode_t op, int16_t y0, int16_t y1,
+    uint8_t arg_len)
+{
+    uint8_t *ptr;
+    uint16_t len = (uint16_t)(CMD_HEADER_SIZE + arg_len);
+
+    if ((len > CMD_MAX_SIZE) || (p_dl->len + len > p_dl->size))
+    {
+        p_dl->is_overflow = 1;
+        return NULL;
+    }
+
+    ptr = p_dl->p_buf + p_dl->len;
+    ptr[0] = (uint8_t)op;
+    ptr[1] = (uint8_t)len;
+    put16(ptr + 2, y0);
+    put16(ptr + 4, y1);
+    p_dl->len = (uint16_t)(p_dl->len + len);
+
+    return ptr + CMD_HEADER_SIZE;
+}
+
+static void
+put_args(lib_u8g2_dlist_t *p_dl, opcode_t op, int16_t y0, int16_t y1,
+    const int16_t *args, uint8_t cnt)
+{
+    uint8_t *p_arg = put_cmd(p_dl, op, y0, y1, (uint8_t)(2 * cnt));
+
+    if (p_arg != NULL)
+    {
+        for (uint8_t i = 0; i < cnt; i++)
+        {
+            put16(p_arg + 2 * i, args[i]);
+        }
+    }
+}
+
+static void
+text_rows(const lib_u8g2_dlist_t *p_dl, int16_t y, int16_t *p_y0,
+    int16_t *p_y1)
+{
+    int8_t y_offset;
+
+    if (p_dl->font == NULL)
+    {
+        *p_y0 = INT16_MIN;
+        *p_y1 = INT16_MAX;
+        return;
+    }
+
+    // Font bounding box relative to baseline
+    y_offset = (int8_t)p_dl->font[FONT_Y_OFFSET];
+    *p_y0 = (int16_t)(y - p_dl->font[FONT_MAX_CHAR_HEIGHT] - y_offset);
+    *p_y1 = (int16_t)(y - y_offset + 1);
+}
+
+static void
+put16(uint8_t *ptr, int16_t value)
+{
+    ptr[0] = (uint8_t)((uint16_t)value & 0xFF);
+    ptr[1] = (uint8_t)((uint16_t)value >> 8);
+}
+
+static int16_t
+get16(const uint8_t *ptr)
+{
+    return (int16_t)(ptr[0] | (ptr[1] << 8));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,237 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_epd.c
+* @version 1.0.0
+*
+* @brief Partial refresh manager for IL3820 and SSD1607 e-paper displays.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+// applibs_versions.h defines the API struct versions to use for applibs APIs.
+#include "applibs_versions.h"
+#include <applibs/gpio.h>
+
+#include <lib_u8g2_epd.h>
+#include <lib_u8g2_dirty.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+#define CMD_MASTER_ACTIVATION       (0x20)
+#define CMD_DISPLAY_UPDATE_CTRL_2   (0x22)
+#define CMD_WRITE_LUT               (0x32)
+#define CMD_NOP                     (0xFF)
+
+#define UPDATE_SEQUENCE             (0xC4)  // Same as u8x8 refresh
+#define LUT_SIZE                    (30)
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static void
+ssd16xx_start_refresh(u8g2_t *u8g2, lib_u8g2_epd_refresh_t type);
+
+static uint8_t
+ssd16xx_is_busy(u8g2_t *u8g2);
+
+static void
+send_area(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+
+const lib_u8g2_epd_transport_t lib_u8g2_epd_ssd16xx = {
+    .start_refresh = ssd16xx_start_refresh,
+    .is_busy = ssd16xx_is_busy
+};
+
+// Waveform tables of IL3820 and SSD1607 panels
+static const uint8_t g_lut_full[LUT_SIZE] = {
+    0x02, 0x02, 0x01, 0x11, 0x12, 0x12, 0x22, 0x22, 0x66, 0x69,
+    0x69, 0x59, 0x58, 0x99, 0x99, 0x88, 0x00, 0x00, 0x00, 0x00,
+    0xF8, 0xB4, 0x13, 0x51, 0x35, 0x51, 0x51, 0x19, 0x01, 0x00
+};
+
+static const uint8_t g_lut_partial[LUT_SIZE] = {
+    0x10, 0x18, 0x18, 0x08, 0x18, 0x18, 0x08, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x13, 0x14, 0x44, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+static int g_fd_busy = -1;
+static lib_u8g2_epd_refresh_t g_lut_loaded = LIB_U8G2_EPD_NONE;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void
+lib_u8g2_EpdSetBusyGpio(int fd_busy)
+{
+    g_fd_busy = fd_busy;
+}
+
+void
+lib_u8g2_EpdInit(lib_u8g2_epd_t *p_epd,
+    const lib_u8g2_epd_transport_t *p_transport, uint8_t max_partial,
+    uint16_t max_area)
+{
+    p_epd->p_transport = p_transport;
+    p_epd->max_partial = max_partial;
+    p_epd->max_area = max_area;
+    p_epd->partial_cnt = 0;
+    p_epd->partial_area = 0;
+    p_epd->is_full_requested = 1;
+    p_epd->running = LIB_U8G2_EPD_NONE;
+}
+
+void
+lib_u8g2_EpdRequestFull(lib_u8g2_epd_t *p_epd)
+{
+    p_epd->is_full_requested = 1;
+}
+
+lib_u8g2_epd_refresh_t
+lib_u8g2_EpdUpdate(u8g2_t *u8g2, lib_u8g2_epd_t *p_epd)
+{
+    uint32_t display_area = (uint32_t)u8g2->pixel_buf_width *
+        u8g2->tile_buf_height * 8;
+    uint32_t area;
+    lib_u8g2_epd_refresh_t type;
+
+    if (p_epd->running != LIB_U8G2_EPD_NONE)
+    {
+        return LIB_U8G2_EPD_BUSY;
+    }
+
+    if (lib_u8g2_GetDirtyArea(u8g2, &p_epd->x0, &p_epd->y0, &p_epd->x1,
+        &p_epd->y1))
+    {
+        area = (uint32_t)(p_epd->x1 - p_epd->x0) *
+            (uint32_t)(p_epd->y1 - p_epd->y0);
+    }
+    else if (p_epd->is_full_requested)
+    {
+        p_epd->x1 = p_epd->x0;
+        area = 0;
+    }
+    else
+    {
+        return LIB_U8G2_EPD_NONE;
+    }
+
+    // Ghosting grows with both count and extent of partial refreshes
+    if (p_epd->is_full_requested ||
+        (p_epd->partial_cnt >= p_epd->max_partial) ||
+        ((p_epd->partial_area + area) * 100 >
+        (uint32_t)p_epd->max_area * display_area))
+    {
+        type = LIB_U8G2_EPD_FULL;
+        p_epd->is_full_requested = 0;
+        p_epd->partial_cnt = 0;
+        p_epd->partial_area = 0;
+    }
+    else
+    {
+        type = LIB_U8G2_EPD_PARTIAL;
+        p_epd->partial_cnt++;
+        p_epd->partial_area += area;
+    }
+
+    lib_u8g2_SendDirty(u8g2);
+    p_epd->p_transport->start_refresh(u8g2, type);
+    p_epd->running = type;
+
+    return type;
+}
+
+lib_u8g2_epd_refresh_t
+lib_u8g2_EpdPoll(u8g2_t *u8g2, lib_u8g2_epd_t *p_epd)
+{
+    lib_u8g2_epd_refresh_t done = p_epd->running;
+
+    if (done == LIB_U8G2_EPD_NONE)
+    {
+        return LIB_U8G2_EPD_NONE;
+    }
+
+    if (p_epd->p_transport->is_busy(u8g2))
+    {
+        return LIB_U8G2_EPD_BUSY;
+    }
+
+    // Controller swaps its two RAM banks on refresh, refreshed area is
+    // written to the other bank too so that next partial refresh starts
+    // from the same picture
+    if (p_epd->x0 < p_epd->x1)
+    {
+        send_area(u8g2, p_epd->x0, p_epd->y0, p_epd->x1, p_epd->y1);
+    }
+    p_epd->running = LIB_U8G2_EPD_NONE;
+
+    return done;
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static void
+ssd16xx_start_refresh(u8g2_t *u8g2, lib_u8g2_epd_refresh_t type)
+{
+    u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+    const uint8_t *p_lut;
+
+    u8x8_cad_StartTransfer(u8x8);
+
+    // Waveform table is loaded only when refresh type changes
+    if (type != g_lut_loaded)
+    {
+        p_lut = (type == LIB_U8G2_EPD_FULL) ? g_lut_full : g_lut_partial;
+        u8x8_cad_SendCmd(u8x8, CMD_WRITE_LUT);
+        for (uint8_t i = 0; i < LUT_SIZE; i++)
+        {
+            u8x8_cad_SendArg(u8x8, p_lut[i]);
+        }
+        g_lut_loaded = type;
+    }
+
+    u8x8_cad_SendCmd(u8x8, CMD_DISPLAY_UPDATE_CTRL_2);
+    u8x8_cad_SendArg(u8x8, UPDATE_SEQUENCE);
+    u8x8_cad_SendCmd(u8x8, CMD_MASTER_ACTIVATION);
+    u8x8_cad_SendCmd(u8x8, CMD_NOP);
+    u8x8_cad_EndTransfer(u8x8);
+}
+
+static uint8_t
+ssd16xx_is_busy(u8g2_t *u8g2)
+{
+    GPIO_Value_Type value = GPIO_Value_Low;
+
+    if ((g_fd_busy >= 0) && (GPIO_GetValue(g_fd_busy, &value) == 0))
+    {
+        return (uint8_t)(value == GPIO_Value_High);
+    }
+
+    return 0;
+}
+
+static void
+send_area(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+    uint8_t tx0 = (uint8_t)(x0 / 8);
+    uint8_t tx1 = (uint8_t)((x1 + 7) / 8);
+
+    for (uint8_t ty = (uint8_t)(y0 / 8); ty < (y1 + 7) / 8; ty++)
+    {
+        u8x8_DrawTile(u8x8, tx0, ty, (uint8_t)(tx1 - tx0),
+            u8g2->tile_buf_ptr + ty * u8g2->pixel_buf_width + tx0 * 8);
+    }
+}
+
+/* [] END OF FILE */
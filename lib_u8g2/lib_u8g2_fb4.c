@@ -0,0 +1,463 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_fb4.c
+* @version 1.0.0
+*
+* @brief 4 bit grayscale frame buffer for SSD1322 and SSD1327 displays.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <string.h>
+
+#include <lib_u8g2_fb4.h>
+#include <lib_u8g2_font.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+#define CMD_SET_COLUMN_ADDRESS      (0x15)
+#define CMD_SET_ROW_ADDRESS         (0x75)
+#define CMD_WRITE_RAM               (0x5C)  // SSD1322 only
+
+#define COVERAGE_SIZE               (LIB_U8G2_FB4_GLYPH_MAX / 2 + 1)
+
+/*******************************************************************************
+* Private types
+*******************************************************************************/
+
+typedef struct
+{
+    uint8_t phase_x;        // Glyph bitmap position within 2x2 block
+    uint8_t phase_y;
+} coverage_ctx_t;
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static uint8_t
+clip_box(const lib_u8g2_fb4_t *p_fb, int16_t *p_x, int16_t *p_y,
+    int16_t *p_w, int16_t *p_h);
+
+static void
+mark_dirty(lib_u8g2_fb4_t *p_fb, int16_t x0, int16_t y0, int16_t x1,
+    int16_t y1);
+
+static void
+fill_row(uint8_t *p_row, int16_t x, int16_t w, uint8_t level);
+
+static uint8_t
+get_pixel(const uint8_t *p_row, int16_t x);
+
+static void
+put_pixel(uint8_t *p_row, int16_t x, uint8_t level);
+
+static void
+coverage_run(void *p_ctx, uint8_t x, uint8_t y, uint8_t len);
+
+static void
+blend_coverage(lib_u8g2_fb4_t *p_fb, int16_t x0, int16_t y0, uint8_t cw,
+    uint8_t ch, uint8_t level);
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+
+// Number of font pixels set in each 2x2 block of current glyph
+static uint8_t g_coverage[COVERAGE_SIZE][COVERAGE_SIZE];
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void
+lib_u8g2_Fb4Init(lib_u8g2_fb4_t *p_fb, uint8_t *p_buf, uint16_t w,
+    uint16_t h, lib_u8g2_fb4_ctrl_t ctrl)
+{
+    p_fb->p_buf = p_buf;
+    p_fb->w = w;
+    p_fb->h = h;
+    p_fb->stride = (uint16_t)(w / 2);
+    p_fb->ctrl = ctrl;
+    p_fb->dirty_x0 = 0;
+    p_fb->dirty_y0 = 0;
+    p_fb->dirty_x1 = (int16_t)w;
+    p_fb->dirty_y1 = (int16_t)h;
+}
+
+void
+lib_u8g2_Fb4Clear(lib_u8g2_fb4_t *p_fb, uint8_t level)
+{
+    memset(p_fb->p_buf, (level & 0x0F) * 0x11,
+        (size_t)p_fb->stride * p_fb->h);
+    mark_dirty(p_fb, 0, 0, (int16_t)p_fb->w, (int16_t)p_fb->h);
+}
+
+void
+lib_u8g2_Fb4DrawPixel(lib_u8g2_fb4_t *p_fb, int16_t x, int16_t y,
+    uint8_t level)
+{
+    if ((x < 0) || (y < 0) || (x >= p_fb->w) || (y >= p_fb->h))
+    {
+        return;
+    }
+
+    put_pixel(p_fb->p_buf + y * p_fb->stride, x, level);
+    mark_dirty(p_fb, x, y, (int16_t)(x + 1), (int16_t)(y + 1));
+}
+
+void
+lib_u8g2_Fb4DrawHSpan(lib_u8g2_fb4_t *p_fb, int16_t x, int16_t y,
+    int16_t w, uint8_t level)
+{
+    lib_u8g2_Fb4DrawBox(p_fb, x, y, w, 1, level);
+}
+
+void
+lib_u8g2_Fb4DrawVSpan(lib_u8g2_fb4_t *p_fb, int16_t x, int16_t y,
+    int16_t h, uint8_t level)
+{
+    lib_u8g2_Fb4DrawBox(p_fb, x, y, 1, h, level);
+}
+
+void
+lib_u8g2_Fb4DrawBox(lib_u8g2_fb4_t *p_fb, int16_t x, int16_t y, int16_t w,
+    int16_t h, uint8_t level)
+{
+    uint8_t *p_row;
+
+    if (!clip_box(p_fb, &x, &y, &w, &h))
+    {
+        return;
+    }
+
+    level &= 0x0F;
+    p_row = p_fb->p_buf + y * p_fb->stride;
+    for (int16_t row = 0; row < h; row++)
+    {
+        fill_row(p_row, x, w, level);
+        p_row += p_fb->stride;
+    }
+
+    mark_dirty(p_fb, x, y, (int16_t)(x + w), (int16_t)(y + h));
+}
+
+void
+lib_u8g2_Fb4Blit(lib_u8g2_fb4_t *p_fb, int16_t x, int16_t y, uint16_t w,
+    uint16_t h, const uint8_t *p_image)
+{
+    uint16_t src_stride = (uint16_t)((w + 1) / 2);
+    int16_t bx = x;
+    int16_t by = y;
+    int16_t bw = (int16_t)w;
+    int16_t bh = (int16_t)h;
+    int16_t sx;
+    int16_t cnt;
+    const uint8_t *p_src;
+    uint8_t *p_dst;
+
+    if (!clip_box(p_fb, &bx, &by, &bw, &bh))
+    {
+        return;
+    }
+
+    // First visible image column and row
+    sx = (int16_t)(bx - x);
+    p_src = p_image + (by - y) * src_stride;
+    p_dst = p_fb->p_buf + by * p_fb->stride;
+
+    for (int16_t row = 0; row < bh; row++)
+    {
+        if (((bx ^ sx) & 1) == 0)
+        {
+            // Same nibble alignment, middle bytes are copied as they are
+            int16_t dx = bx;
+            int16_t ix = sx;
+
+            cnt = bw;
+            if (dx & 1)
+            {
+                put_pixel(p_dst, dx++, get_pixel(p_src, ix++));
+                cnt--;
+            }
+            memcpy(p_dst + dx / 2, p_src + ix / 2, (size_t)(cnt / 2));
+            if (cnt & 1)
+            {
+                put_pixel(p_dst, (int16_t)(dx + cnt - 1),
+                    get_pixel(p_src, (int16_t)(ix + cnt - 1)));
+            }
+        }
+        else
+        {
+            for (int16_t i = 0; i < bw; i++)
+            {
+                put_pixel(p_dst, (int16_t)(bx + i),
+                    get_pixel(p_src, (int16_t)(sx + i)));
+            }
+        }
+        p_src += src_stride;
+        p_dst += p_fb->stride;
+    }
+
+    mark_dirty(p_fb, bx, by, (int16_t)(bx + bw), (int16_t)(by + bh));
+}
+
+int16_t
+lib_u8g2_Fb4DrawUTF8(lib_u8g2_fb4_t *p_fb, u8g2_t *u8g2, int16_t x,
+    int16_t y, const char *s, uint8_t level)
+{
+    lib_u8g2_glyph_info_t info;
+    coverage_ctx_t ctx;
+    const uint8_t *glyph_data;
+    uint16_t encoding;
+    int16_t fx;
+    int16_t fy;
+    int16_t gx;
+    int16_t gy;
+    uint8_t cw;
+    uint8_t ch;
+
+    // Pen position in font pixels, half of display pixels
+    fx = (int16_t)(x * 2);
+    fy = (int16_t)(y * 2 + (u8g2_int_t)u8g2->font_calc_vref(u8g2));
+
+    while ((encoding = lib_u8g2_NextUTF8(&s)) != 0)
+    {
+        glyph_data = lib_u8g2_GetGlyphData(u8g2, encoding);
+        if (glyph_data == NULL)
+        {
+            continue;
+        }
+
+        lib_u8g2_DecodeGlyph(u8g2, glyph_data, &info, NULL, NULL);
+        if (info.width > 0)
+        {
+            gx = (int16_t)(fx + info.x);
+            gy = (int16_t)(fy + info.y);
+            ctx.phase_x = (uint8_t)(gx & 1);
+            ctx.phase_y = (uint8_t)(gy & 1);
+            cw = (uint8_t)((ctx.phase_x + info.width + 1) / 2);
+            ch = (uint8_t)((ctx.phase_y + info.height + 1) / 2);
+            cw = (cw > COVERAGE_SIZE) ? COVERAGE_SIZE : cw;
+            ch = (ch > COVERAGE_SIZE) ? COVERAGE_SIZE : ch;
+
+            for (uint8_t row = 0; row < ch; row++)
+            {
+                memset(g_coverage[row], 0, cw);
+            }
+            lib_u8g2_DecodeGlyph(u8g2, glyph_data, &info, coverage_run,
+                &ctx);
+            blend_coverage(p_fb, (int16_t)((gx - ctx.phase_x) / 2),
+                (int16_t)((gy - ctx.phase_y) / 2), cw, ch,
+                (uint8_t)(level & 0x0F));
+        }
+        fx = (int16_t)(fx + info.delta);
+    }
+
+    return (int16_t)((fx - x * 2) / 2);
+}
+
+uint8_t
+lib_u8g2_Fb4Send(lib_u8g2_fb4_t *p_fb, u8g2_t *u8g2)
+{
+    u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+    int16_t unit = (p_fb->ctrl == LIB_U8G2_FB4_SSD1322) ? 4 : 2;
+    int16_t x0 = p_fb->dirty_x0;
+    int16_t x1 = p_fb->dirty_x1;
+    const uint8_t *p_row;
+
+    if ((x0 >= x1) || (p_fb->dirty_y0 >= p_fb->dirty_y1))
+    {
+        return 0;
+    }
+
+    // Window columns are addressed in controller column units
+    x0 = (int16_t)(x0 / unit * unit);
+    x1 = (int16_t)((x1 + unit - 1) / unit * unit);
+
+    u8x8_cad_StartTransfer(u8x8);
+    u8x8_cad_SendCmd(u8x8, CMD_SET_COLUMN_ADDRESS);
+    u8x8_cad_SendArg(u8x8, (uint8_t)(x0 / unit + u8x8->x_offset));
+    u8x8_cad_SendArg(u8x8, (uint8_t)(x1 / unit - 1 + u8x8->x_offset));
+    u8x8_cad_SendCmd(u8x8, CMD_SET_ROW_ADDRESS);
+    u8x8_cad_SendArg(u8x8, (uint8_t)p_fb->dirty_y0);
+    u8x8_cad_SendArg(u8x8, (uint8_t)(p_fb->dirty_y1 - 1));
+    if (p_fb->ctrl == LIB_U8G2_FB4_SSD1322)
+    {
+        u8x8_cad_SendCmd(u8x8, CMD_WRITE_RAM);
+    }
+
+    // Controller wraps to next window row, row slices are sent as they are
+    p_row = p_fb->p_buf + p_fb->dirty_y0 * p_fb->stride + x0 / 2;
+    for (int16_t y = p_fb->dirty_y0; y < p_fb->dirty_y1; y++)
+    {
+        u8x8_cad_SendData(u8x8, (uint8_t)((x1 - x0) / 2), (uint8_t *)p_row);
+        p_row += p_fb->stride;
+    }
+
+    u8x8_cad_EndTransfer(u8x8);
+
+    p_fb->dirty_x1 = p_fb->dirty_x0;
+
+    return 1;
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static uint8_t
+clip_box(const lib_u8g2_fb4_t *p_fb, int16_t *p_x, int16_t *p_y,
+    int16_t *p_w, int16_t *p_h)
+{
+    int16_t x0 = *p_x;
+    int16_t y0 = *p_y;
+    int16_t x1 = (int16_t)(x0 + *p_w);
+    int16_t y1 = (int16_t)(y0 + *p_h);
+
+    x0 = (x0 < 0) ? 0 : x0;
+    y0 = (y0 < 0) ? 0 : y0;
+    x1 = (x1 > (int16_t)p_fb->w) ? (int16_t)p_fb->w : x1;
+    y1 = (y1 > (int16_t)p_fb->h) ? (int16_t)p_fb->h : y1;
+
+    if ((x0 >= x1) || (y0 >= y1))
+    {
+        return 0;
+    }
+
+    *p_x = x0;
+    *p_y = y0;
+    *p_w = (int16_t)(x1 - x0);
+    *p_h = (int16_t)(y1 - y0);
+
+    return 1;
+}
+
+static void
+mark_dirty(lib_u8g2_fb4_t *p_fb, int16_t x0, int16_t y0, int16_t x1,
+    int16_t y1)
+{
+    if (p_fb->dirty_x0 >= p_fb->dirty_x1)
+    {
+        p_fb->dirty_x0 = x0;
+        p_fb->dirty_y0 = y0;
+        p_fb->dirty_x1 = x1;
+        p_fb->dirty_y1 = y1;
+        return;
+    }
+
+    p_fb->dirty_x0 = (x0 < p_fb->dirty_x0) ? x0 : p_fb->dirty_x0;
+    p_fb->dirty_y0 = (y0 < p_fb->dirty_y0) ? y0 : p_fb->dirty_y0;
+    p_fb->dirty_x1 = (x1 > p_fb->dirty_x1) ? x1 : p_fb->dirty_x1;
+    p_fb->dirty_y1 = (y1 > p_fb->dirty_y1) ? y1 : p_fb->dirty_y1;
+}
+
+static void
+fill_row(uint8_t *p_row, int16_t x, int16_t w, uint8_t level)
+{
+    uint8_t *p = p_row + x / 2;
+
+    if (x & 1)
+    {
+        *p = (uint8_t)((*p & 0xF0) | level);
+        p++;
+        w--;
+    }
+
+    if (w >= 2)
+    {
+        memset(p, level * 0x11, (size_t)(w / 2));
+        p += w / 2;
+    }
+
+    if (w & 1)
+    {
+        *p = (uint8_t)((*p & 0x0F) | (level << 4));
+    }
+}
+
+static uint8_t
+get_pixel(const uint8_t *p_row, int16_t x)
+{
+    return (uint8_t)((x & 1) ? (p_row[x / 2] & 0x0F) : (p_row[x / 2] >> 4));
+}
+
+static void
+put_pixel(uint8_t *p_row, int16_t x, uint8_t level)
+{
+    uint8_t *p = p_row + x / 2;
+
+    level &= 0x0F;
+    if (x & 1)
+    {
+        *p = (uint8_t)((*p & 0xF0) | level);
+    }
+    else
+    {
+        *p = (uint8_t)((*p & 0x0F) | (level << 4));
+    }
+}
+
+static void
+coverage_run(void *p_ctx, uint8_t x, uint8_t y, uint8_t len)
+{
+    const coverage_ctx_t *p_cov = (const coverage_ctx_t *)p_ctx;
+    uint16_t row = (uint16_t)((p_cov->phase_y + y) / 2);
+    uint16_t col;
+
+    if (row >= COVERAGE_SIZE)
+    {
+        return;
+    }
+
+    for (uint16_t i = 0; i < len; i++)
+    {
+        col = (uint16_t)((p_cov->phase_x + x + i) / 2);
+        if (col >= COVERAGE_SIZE)
+        {
+            break;
+        }
+        g_coverage[row][col]++;
+    }
+}
+
+static void
+blend_coverage(lib_u8g2_fb4_t *p_fb, int16_t x0, int16_t y0, uint8_t cw,
+    uint8_t ch, uint8_t level)
+{
+    int16_t bx = x0;
+    int16_t by = y0;
+    int16_t bw = cw;
+    int16_t bh = ch;
+    uint8_t *p_row;
+    uint8_t cov;
+    uint8_t dst;
+
+    if (!clip_box(p_fb, &bx, &by, &bw, &bh))
+    {
+        return;
+    }
+
+    p_row = p_fb->p_buf + by * p_fb->stride;
+    for (int16_t y = by; y < by + bh; y++)
+    {
+        for (int16_t x = bx; x < bx + bw; x++)
+        {
+            cov = g_coverage[y - y0][x - x0];
+            if (cov > 0)
+            {
+                // Blend text level over background by covered fraction
+                dst = get_pixel(p_row, x);
+                put_pixel(p_row, x,
+                    (uint8_t)((dst * (4 - cov) + level * cov + 2) / 4));
+            }
+        }
+        p_row += p_fb->stride;
+    }
+
+    mark_dirty(p_fb, bx, by, (int16_t)(bx + bw), (int16_t)(by + bh));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,681 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_font.c
+* @version 1.0.0
+*
+* @brief Indexed glyph lookup and drawing for large Unicode u8g2 fonts.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <lib_u8g2_font.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+#define FONT_OFFSET_UNICODE     (21)    // Header offset of start_pos_unicode
+
+/*******************************************************************************
+* Private types
+*******************************************************************************/
+
+typedef struct
+{
+    const uint8_t *font;    // Indexed font, NULL if slot is unused
+    const uint8_t *glyphs;  // First Unicode glyph record of font
+    uint16_t *encoding;     // Sorted glyph encodings
+    uint32_t *offset;       // Glyph record offsets relative to glyphs
+    uint16_t count;         // Number of indexed glyphs
+} glyph_index_t;
+
+typedef struct
+{
+    const uint8_t *ptr;     // Current glyph bitstream byte
+    uint8_t bit_pos;        // Bit position within current byte
+    uint8_t width;          // Glyph bitmap width
+    uint8_t height;         // Glyph bitmap height
+    uint8_t x;              // Decoder position within glyph bitmap
+    uint8_t y;
+} glyph_decoder_t;
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static glyph_index_t *
+index_find(const uint8_t *font);
+
+static glyph_index_t *
+index_build(const uint8_t *font);
+
+static void *
+index_alloc(size_t size);
+
+static uint8_t
+decode_bits(glyph_decoder_t *dec, uint8_t cnt);
+
+static int8_t
+decode_signed_bits(glyph_decoder_t *dec, uint8_t cnt);
+
+static void
+decode_run(u8g2_t *u8g2, glyph_decoder_t *dec, u8g2_uint_t x, u8g2_uint_t y,
+    uint8_t len, uint8_t is_foreground);
+
+static int8_t
+decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data,
+    u8g2_uint_t x, u8g2_uint_t y);
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+
+static glyph_index_t g_index[LIB_U8G2_GLYPH_INDEX_FONTS];
+static uint8_t g_index_next;        // Next slot to be replaced
+
+// Recently selected fonts which can not be indexed
+static const uint8_t *g_unindexed[LIB_U8G2_GLYPH_INDEX_FONTS];
+static uint8_t g_unindexed_next;
+
+#ifndef LIB_U8G2_GLYPH_INDEX_USE_HEAP
+static uint32_t g_arena[LIB_U8G2_GLYPH_INDEX_ARENA_SIZE / sizeof(uint32_t)];
+static size_t g_arena_used;         // Used arena size in 32-bit words
+#endif
+
+static const glyph_index_t *g_index_current;    // Index of current font
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void
+lib_u8g2_SetFont(u8g2_t *u8g2, const uint8_t *font)
+{
+    u8g2_SetFont(u8g2, font);
+
+    g_index_current = index_find(font);
+    if (g_index_current != NULL)
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; i < LIB_U8G2_GLYPH_INDEX_FONTS; i++)
+    {
+        if (g_unindexed[i] == font)
+        {
+            return;
+        }
+    }
+
+    g_index_current = index_build(font);
+    if (g_index_current == NULL)
+    {
+        // Do not walk the font again next time it is selected
+        g_unindexed[g_unindexed_next] = font;
+        g_unindexed_next = (uint8_t)((g_unindexed_next + 1) %
+            LIB_U8G2_GLYPH_INDEX_FONTS);
+    }
+}
+
+const uint8_t *
+lib_u8g2_GetGlyphData(u8g2_t *u8g2, uint16_t encoding)
+{
+    const glyph_index_t *p_index = g_index_current;
+    uint16_t lo;
+    uint16_t hi;
+    uint16_t mid;
+
+    if ((encoding <= 0xFF) || (p_index == NULL) ||
+        (p_index->font != u8g2->font))
+    {
+        // ASCII range is already sped up by u8g2 'A' and 'a' start offsets
+        return u8g2_font_get_glyph_data(u8g2, encoding);
+    }
+
+    lo = 0;
+    hi = p_index->count;
+    while (lo < hi)
+    {
+        mid = (uint16_t)((lo + hi) / 2);
+        if (p_index->encoding[mid] < encoding)
+        {
+            lo = (uint16_t)(mid + 1);
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    if ((lo < p_index->count) && (p_index->encoding[lo] == encoding))
+    {
+        // Skip 2 bytes of encoding and 1 byte of glyph record size
+        return p_index->glyphs + p_index->offset[lo] + 3;
+    }
+
+    return NULL;
+}
+
+u8g2_uint_t
+lib_u8g2_DrawGlyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    uint16_t encoding)
+{
+    const uint8_t *glyph_data;
+
+#ifdef U8G2_WITH_FONT_ROTATION
+    switch (u8g2->font_decode.dir)
+    {
+        case 0:
+            y += u8g2->font_calc_vref(u8g2);
+        break;
+
+        case 1:
+            x -= u8g2->font_calc_vref(u8g2);
+        break;
+
+        case 2:
+            y -= u8g2->font_calc_vref(u8g2);
+        break;
+
+        case 3:
+            x += u8g2->font_calc_vref(u8g2);
+        break;
+    }
+#else
+    y += u8g2->font_calc_vref(u8g2);
+#endif
+
+    glyph_data = lib_u8g2_GetGlyphData(u8g2, encoding);
+    if (glyph_data == NULL)
+    {
+        return 0;
+    }
+
+    return (u8g2_uint_t)decode_glyph(u8g2, glyph_data, x, y);
+}
+
+u8g2_uint_t
+lib_u8g2_DrawUTF8(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const char *s)
+{
+    const char *p = s;
+    u8g2_uint_t sum = 0;
+    u8g2_uint_t delta;
+    uint16_t encoding;
+
+    while ((encoding = lib_u8g2_NextUTF8(&p)) != 0)
+    {
+        delta = lib_u8g2_DrawGlyph(u8g2, x, y, encoding);
+
+#ifdef U8G2_WITH_FONT_ROTATION
+        switch (u8g2->font_decode.dir)
+        {
+            case 0:
+                x += delta;
+            break;
+
+            case 1:
+                y += delta;
+            break;
+
+            case 2:
+                x -= delta;
+            break;
+
+            case 3:
+                y -= delta;
+            break;
+        }
+#else
+        x += delta;
+#endif
+        sum += delta;
+    }
+
+    return sum;
+}
+
+uint16_t
+lib_u8g2_NextUTF8(const char **p_s)
+{
+    const uint8_t *p = (const uint8_t *)*p_s;
+    uint16_t encoding = 0;
+
+    while (*p != 0)
+    {
+        // Decode UTF-8 sequence of up to 3 bytes (BMP only)
+        if (*p < 0x80)
+        {
+            encoding = *p++;
+            break;
+        }
+        else if (((*p & 0xE0) == 0xC0) && (p[1] != 0))
+        {
+            encoding = (uint16_t)(((p[0] & 0x1F) << 6) | (p[1] & 0x3F));
+            p += 2;
+            break;
+        }
+        else if (((*p & 0xF0) == 0xE0) && (p[1] != 0) && (p[2] != 0))
+        {
+            encoding = (uint16_t)(((p[0] & 0x0F) << 12) |
+                ((p[1] & 0x3F) << 6) | (p[2] & 0x3F));
+            p += 3;
+            break;
+        }
+
+        // Skip invalid or unsupported byte
+        p++;
+    }
+
+    *p_s = (const char *)p;
+
+    return encoding;
+}
+
+void
+lib_u8g2_DecodeGlyph(u8g2_t *u8g2, const uint8_t *glyph_data,
+    lib_u8g2_glyph_info_t *p_info, lib_u8g2_glyph_run_cb run_cb, void *p_ctx)
+{
+    glyph_decoder_t dec;
+    uint8_t run_0;
+    uint8_t run_1;
+    uint8_t len;
+    uint8_t current;
+
+    dec.ptr = glyph_data;
+    dec.bit_pos = 0;
+    dec.width = decode_bits(&dec, u8g2->font_info.bits_per_char_width);
+    dec.height = decode_bits(&dec, u8g2->font_info.bits_per_char_height);
+    dec.x = 0;
+    dec.y = 0;
+
+    p_info->width = dec.width;
+    p_info->height = dec.height;
+    p_info->x = decode_signed_bits(&dec, u8g2->font_info.bits_per_char_x);
+    p_info->y = (int8_t)(-(dec.height +
+        decode_signed_bits(&dec, u8g2->font_info.bits_per_char_y)));
+    p_info->delta = decode_signed_bits(&dec,
+        u8g2->font_info.bits_per_delta_x);
+
+    if ((dec.width == 0) || (run_cb == NULL))
+    {
+        return;
+    }
+
+    for (;;)
+    {
+        run_0 = decode_bits(&dec, u8g2->font_info.bits_per_0);
+        run_1 = decode_bits(&dec, u8g2->font_info.bits_per_1);
+        do
+        {
+            // Skip background run, report foreground run split at lines
+            len = run_0;
+            while (len >= dec.width - dec.x)
+            {
+                len = (uint8_t)(len - (dec.width - dec.x));
+                dec.x = 0;
+                dec.y++;
+            }
+            dec.x = (uint8_t)(dec.x + len);
+
+            len = run_1;
+            while (len > 0)
+            {
+                current = (uint8_t)(dec.width - dec.x);
+                if (len < current)
+                {
+                    current = len;
+                }
+                run_cb(p_ctx, dec.x, dec.y, current);
+                len = (uint8_t)(len - current);
+                dec.x = (uint8_t)(dec.x + current);
+                if (dec.x >= dec.width)
+                {
+                    dec.x = 0;
+                    dec.y++;
+                }
+            }
+        } while (decode_bits(&dec, 1) != 0);
+
+        if (dec.y >= dec.height)
+        {
+            break;
+        }
+    }
+}
+
+void
+lib_u8g2_ResetGlyphIndex(void)
+{
+#ifdef LIB_U8G2_GLYPH_INDEX_USE_HEAP
+    for (uint8_t i = 0; i < LIB_U8G2_GLYPH_INDEX_FONTS; i++)
+    {
+        free(g_index[i].encoding);
+        free(g_index[i].offset);
+    }
+#else
+    g_arena_used = 0;
+#endif
+
+    memset(g_index, 0, sizeof(g_index));
+    memset(g_unindexed, 0, sizeof(g_unindexed));
+    g_index_next = 0;
+    g_unindexed_next = 0;
+    g_index_current = NULL;
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static glyph_index_t *
+index_find(const uint8_t *font)
+{
+    for (uint8_t i = 0; i < LIB_U8G2_GLYPH_INDEX_FONTS; i++)
+    {
+        if (g_index[i].font == font)
+        {
+            return &g_index[i];
+        }
+    }
+    return NULL;
+}
+
+static glyph_index_t *
+index_build(const uint8_t *font)
+{
+    glyph_index_t *p_index;
+    const uint8_t *table;
+    const uint8_t *glyphs;
+    const uint8_t *p;
+    uint16_t count = 0;
+    uint16_t encoding;
+
+    // Locate Unicode jump table, the first entry skips the table itself
+    table = font + U8G2_FONT_DATA_STRUCT_SIZE +
+        ((u8x8_pgm_read(font + FONT_OFFSET_UNICODE) << 8) |
+        u8x8_pgm_read(font + FONT_OFFSET_UNICODE + 1));
+
+    // Unicode section follows 8-bit glyphs, do not trust fonts without it
+    p = font + U8G2_FONT_DATA_STRUCT_SIZE;
+    while (u8x8_pgm_read(p + 1) != 0)
+    {
+        p += u8x8_pgm_read(p + 1);
+    }
+    if (table < p + 2)
+    {
+        return NULL;
+    }
+
+    glyphs = table +
+        ((u8x8_pgm_read(table) << 8) | u8x8_pgm_read(table + 1));
+
+    // Count glyphs
+    p = glyphs;
+    while ((u8x8_pgm_read(p) | u8x8_pgm_read(p + 1)) != 0)
+    {
+        if (count == UINT16_MAX)
+        {
+            return NULL;
+        }
+        count++;
+        p += u8x8_pgm_read(p + 2);
+    }
+
+    if (count == 0)
+    {
+        // Font without Unicode glyphs, nothing to index
+        return NULL;
+    }
+
+    // Select slot, round robin in heap mode, full reset in arena mode
+    if (g_index[g_index_next].font != NULL)
+    {
+#ifdef LIB_U8G2_GLYPH_INDEX_USE_HEAP
+        free(g_index[g_index_next].encoding);
+        free(g_index[g_index_next].offset);
+        memset(&g_index[g_index_next], 0, sizeof(glyph_index_t));
+#else
+        lib_u8g2_ResetGlyphIndex();
+#endif
+    }
+
+    p_index = &g_index[g_index_next];
+    p_index->offset = index_alloc(count * sizeof(uint32_t));
+    p_index->encoding = index_alloc(count * sizeof(uint16_t));
+
+#ifndef LIB_U8G2_GLYPH_INDEX_USE_HEAP
+    if ((p_index->offset == NULL) || (p_index->encoding == NULL))
+    {
+        // Arena exhausted by other fonts, start over with this one
+        lib_u8g2_ResetGlyphIndex();
+        p_index->offset = index_alloc(count * sizeof(uint32_t));
+        p_index->encoding = index_alloc(count * sizeof(uint16_t));
+    }
+#endif
+
+    if ((p_index->offset == NULL) || (p_index->encoding == NULL))
+    {
+#ifdef LIB_U8G2_GLYPH_INDEX_USE_HEAP
+        free(p_index->encoding);
+        free(p_index->offset);
+#endif
+        memset(p_index, 0, sizeof(glyph_index_t));
+        return NULL;
+    }
+
+    // Glyph records are stored in ascending encoding order
+    count = 0;
+    p = glyphs;
+    while ((encoding = (uint16_t)((u8x8_pgm_read(p) << 8) |
+        u8x8_pgm_read(p + 1))) != 0)
+    {
+        p_index->encoding[count] = encoding;
+        p_index->offset[count] = (uint32_t)(p - glyphs);
+        count++;
+        p += u8x8_pgm_read(p + 2);
+    }
+
+    p_index->font = font;
+    p_index->glyphs = glyphs;
+    p_index->count = count;
+
+    g_index_next = (uint8_t)((g_index_next + 1) % LIB_U8G2_GLYPH_INDEX_FONTS);
+
+    return p_index;
+}
+
+static void *
+index_alloc(size_t size)
+{
+#ifdef LIB_U8G2_GLYPH_INDEX_USE_HEAP
+    return malloc(size);
+#else
+    size_t words = (size + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    void *p_block;
+
+    if (words > (sizeof(g_arena) / sizeof(uint32_t)) - g_arena_used)
+    {
+        return NULL;
+    }
+
+    p_block = &g_arena[g_arena_used];
+    g_arena_used += words;
+    return p_block;
+#endif
+}
+
+static uint8_t
+decode_bits(glyph_decoder_t *dec, uint8_t cnt)
+{
+    uint8_t val;
+    uint8_t bit_pos = dec->bit_pos;
+
+    val = (uint8_t)(u8x8_pgm_read(dec->ptr) >> bit_pos);
+    bit_pos = (uint8_t)(bit_pos + cnt);
+    if (bit_pos >= 8)
+    {
+        dec->ptr++;
+        val = (uint8_t)(val |
+            (u8x8_pgm_read(dec->ptr) << (8 - dec->bit_pos)));
+        bit_pos = (uint8_t)(bit_pos - 8);
+    }
+    dec->bit_pos = bit_pos;
+
+    return (uint8_t)(val & ((1u << cnt) - 1));
+}
+
+static int8_t
+decode_signed_bits(glyph_decoder_t *dec, uint8_t cnt)
+{
+    return (int8_t)(decode_bits(dec, cnt) - (1 << (cnt - 1)));
+}
+
+static void
+decode_run(u8g2_t *u8g2, glyph_decoder_t *dec, u8g2_uint_t x, u8g2_uint_t y,
+    uint8_t len, uint8_t is_foreground)
+{
+    uint8_t dir = 0;
+    uint8_t rem;
+    uint8_t current;
+    u8g2_uint_t px;
+    u8g2_uint_t py;
+
+#ifdef U8G2_WITH_FONT_ROTATION
+    dir = u8g2->font_decode.dir;
+#endif
+
+    // Runs wrap around glyph bitmap lines
+    for (;;)
+    {
+        rem = (uint8_t)(dec->width - dec->x);
+        current = (len < rem) ? len : rem;
+
+        switch (dir)
+        {
+            case 1:
+                px = (u8g2_uint_t)(x - dec->y);
+                py = (u8g2_uint_t)(y + dec->x);
+            break;
+
+            case 2:
+                px = (u8g2_uint_t)(x - dec->x);
+                py = (u8g2_uint_t)(y - dec->y);
+            break;
+
+            case 3:
+                px = (u8g2_uint_t)(x + dec->y);
+                py = (u8g2_uint_t)(y - dec->x);
+            break;
+
+            default:
+                px = (u8g2_uint_t)(x + dec->x);
+                py = (u8g2_uint_t)(y + dec->y);
+            break;
+        }
+
+        if ((current > 0) &&
+            (is_foreground || (u8g2->font_decode.is_transparent == 0)))
+        {
+            u8g2_DrawHVLine(u8g2, px, py, current, dir);
+        }
+
+        if (len < rem)
+        {
+            dec->x = (uint8_t)(dec->x + len);
+            break;
+        }
+
+        len = (uint8_t)(len - rem);
+        dec->x = 0;
+        dec->y++;
+    }
+}
+
+static int8_t
+decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data,
+    u8g2_uint_t x, u8g2_uint_t y)
+{
+    glyph_decoder_t dec;
+    uint8_t fg_color = u8g2->draw_color;
+    uint8_t bg_color = (fg_color == 0) ? 1 : 0;
+    uint8_t dir = 0;
+    int8_t off_x;
+    int8_t off_y;
+    int8_t delta;
+    uint8_t run_0;
+    uint8_t run_1;
+
+#ifdef U8G2_WITH_FONT_ROTATION
+    dir = u8g2->font_decode.dir;
+#endif
+
+    dec.ptr = glyph_data;
+    dec.bit_pos = 0;
+    dec.width = decode_bits(&dec, u8g2->font_info.bits_per_char_width);
+    dec.height = decode_bits(&dec, u8g2->font_info.bits_per_char_height);
+    dec.x = 0;
+    dec.y = 0;
+
+    off_x = decode_signed_bits(&dec, u8g2->font_info.bits_per_char_x);
+    off_y = decode_signed_bits(&dec, u8g2->font_info.bits_per_char_y);
+    delta = decode_signed_bits(&dec, u8g2->font_info.bits_per_delta_x);
+
+    if (dec.width == 0)
+    {
+        return delta;
+    }
+
+    // Move target to upper left corner of glyph bitmap
+    off_y = (int8_t)(-(dec.height + off_y));
+    switch (dir)
+    {
+        case 1:
+            x = (u8g2_uint_t)(x - off_y);
+            y = (u8g2_uint_t)(y + off_x);
+        break;
+
+        case 2:
+            x = (u8g2_uint_t)(x - off_x);
+            y = (u8g2_uint_t)(y - off_y);
+        break;
+
+        case 3:
+            x = (u8g2_uint_t)(x + off_y);
+            y = (u8g2_uint_t)(y - off_x);
+        break;
+
+        default:
+            x = (u8g2_uint_t)(x + off_x);
+            y = (u8g2_uint_t)(y + off_y);
+        break;
+    }
+
+    // Glyph bitmap is a sequence of (0-run, 1-run) pairs, each pair may be
+    // followed by repeat bits
+    for (;;)
+    {
+        run_0 = decode_bits(&dec, u8g2->font_info.bits_per_0);
+        run_1 = decode_bits(&dec, u8g2->font_info.bits_per_1);
+        do
+        {
+            u8g2->draw_color = bg_color;
+            decode_run(u8g2, &dec, x, y, run_0, 0);
+            u8g2->draw_color = fg_color;
+            decode_run(u8g2, &dec, x, y, run_1, 1);
+        } while (decode_bits(&dec, 1) != 0);
+
+        if (dec.y >= dec.height)
+        {
+            break;
+        }
+    }
+
+    u8g2->draw_color = fg_color;
+
+    return delta;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,413 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_gauge.c
+* @version 1.0.0
+*
+* @brief Dial gauges, arc meters and bar graphs with partial redraw.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <lib_u8g2_gauge.h>
+#include <lib_u8g2_span.h>
+#include <lib_u8g2_dirty.h>
+#include <lib_u8g2_region.h>
+#include <lib_u8g2_circle.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+// Angle units per radian, angle step giving one pixel spacing at radius r
+// is ANGLE_RADIAN / r
+#define ANGLE_RADIAN                        (163)
+
+// Dial tick length, needle gap to ticks and hub radius
+#define DIAL_TICK                           (3)
+#define DIAL_GAP                            (2)
+#define DIAL_HUB                            (2)
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static uint8_t
+is_supported(u8g2_t *u8g2);
+
+static int16_t
+gauge_position(const lib_u8g2_gauge_t *p_gauge, int16_t value);
+
+static int16_t
+arc_lines(const lib_u8g2_gauge_t *p_gauge);
+
+static void
+draw_radial(u8g2_t *u8g2, const lib_u8g2_gauge_t *p_gauge, uint16_t angle,
+    int16_t r0, int16_t r1);
+
+static void
+draw_arc_lines(u8g2_t *u8g2, const lib_u8g2_gauge_t *p_gauge, int16_t first,
+    int16_t last);
+
+static void
+draw_needle(u8g2_t *u8g2, const lib_u8g2_gauge_t *p_gauge, uint8_t color);
+
+static void
+draw_bar(u8g2_t *u8g2, const lib_u8g2_gauge_t *p_gauge, int16_t from,
+    int16_t to);
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+
+// Sine of first quadrant in Q14, 256 steps per quadrant
+static const int16_t g_sin_q14[257] =
+{
+        0,   101,   201,   302,   402,   503,   603,   704,   804,   904,
+     1005,  1105,  1205,  1306,  1406,  1506,  1606,  1706,  1806,  1906,
+     2006,  2105,  2205,  2305,  2404,  2503,  2603,  2702,  2801,  2900,
+     2999,  3098,  3196,  3295,  3393,  3492,  3590,  3688,  3786,  3883,
+     3981,  4078,  4176,  4273,  4370,  4467,  4563,  4660,  4756,  4852,
+     4948,  5044,  5139,  5235,  5330,  5425,  5520,  5614,  5708,  5803,
+     5897,  5990,  6084,  6177,  6270,  6363,  6455,  6547,  6639,  6731,
+     6823,  6914,  7005,  7096,  7186,  7276,  7366,  7456,  7545,  7635,
+     7723,  7812,  7900,  7988,  8076,  8163,  8250,  8337,  8423,  8509,
+     8595,  8680,  8765,  8850,  8935,  9019,  9102,  9186,  9269,  9352,
+     9434,  9516,  9598,  9679,  9760,  9841,  9921, 10001, 10080, 10159,
+    10238, 10316, 10394, 10471, 10549, 10625, 10702, 10778, 10853, 10928,
+    11003, 11077, 11151, 11224, 11297, 11370, 11442, 11514, 11585, 11656,
+    11727, 11797, 11866, 11935, 12004, 12072, 12140, 12207, 12274, 12340,
+    12406, 12472, 12537, 12601, 12665, 12729, 12792, 12854, 12916, 12978,
+    13039, 13100, 13160, 13219, 13279, 13337, 13395, 13453, 13510, 13567,
+    13623, 13678, 13733, 13788, 13842, 13896, 13949, 14001, 14053, 14104,
+    14155, 14206, 14256, 14305, 14354, 14402, 14449, 14497, 14543, 14589,
+    14635, 14680, 14724, 14768, 14811, 14854, 14896, 14937, 14978, 15019,
+    15059, 15098, 15137, 15175, 15213, 15250, 15286, 15322, 15357, 15392,
+    15426, 15460, 15493, 15525, 15557, 15588, 15619, 15649, 15679, 15707,
+    15736, 15763, 15791, 15817, 15843, 15868, 15893, 15917, 15941, 15964,
+    15986, 16008, 16029, 16049, 16069, 16088, 16107, 16125, 16143, 16160,
+    16176, 16192, 16207, 16221, 16235, 16248, 16261, 16273, 16284, 16295,
+    16305, 16315, 16324, 16332, 16340, 16347, 16353, 16359, 16364, 16369,
+    16373, 16376, 16379, 16381, 16383, 16384, 16384
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+int16_t
+lib_u8g2_Sin(uint16_t angle)
+{
+    uint16_t a = (uint16_t)(angle & (LIB_U8G2_ANGLE_TURN - 1));
+    uint16_t q = (uint16_t)(a & (LIB_U8G2_ANGLE_TURN / 4 - 1));
+    int16_t result;
+
+    // Second and fourth quadrants mirror the table
+    if (a & (LIB_U8G2_ANGLE_TURN / 4))
+    {
+        q = (uint16_t)(LIB_U8G2_ANGLE_TURN / 4 - q);
+    }
+
+    result = g_sin_q14[q];
+
+    return (a & (LIB_U8G2_ANGLE_TURN / 2)) ? (int16_t)-result : result;
+}
+
+int16_t
+lib_u8g2_Cos(uint16_t angle)
+{
+    return lib_u8g2_Sin((uint16_t)(angle + LIB_U8G2_ANGLE_TURN / 4));
+}
+
+void
+lib_u8g2_GaugeInitDial(lib_u8g2_gauge_t *p_gauge, int16_t cx, int16_t cy,
+    int16_t r, uint16_t start, uint16_t sweep, int16_t min, int16_t max)
+{
+    p_gauge->type = LIB_U8G2_GAUGE_DIAL;
+    p_gauge->x = cx;
+    p_gauge->y = cy;
+    p_gauge->w = (int16_t)(2 * r + 1);
+    p_gauge->h = (int16_t)(2 * r + 1);
+    p_gauge->r_in = 0;
+    p_gauge->r_out = r;
+    p_gauge->start = start;
+    p_gauge->sweep = sweep;
+    p_gauge->step = 1;
+    p_gauge->min = min;
+    p_gauge->max = (max > min) ? max : (int16_t)(min + 1);
+    p_gauge->shown = 0;
+}
+
+void
+lib_u8g2_GaugeInitArc(lib_u8g2_gauge_t *p_gauge, int16_t cx, int16_t cy,
+    int16_t r_in, int16_t r_out, uint16_t start, uint16_t sweep, int16_t min,
+    int16_t max)
+{
+    lib_u8g2_GaugeInitDial(p_gauge, cx, cy, r_out, start, sweep, min, max);
+    p_gauge->type = LIB_U8G2_GAUGE_ARC;
+    p_gauge->r_in = (r_in > 0) ? r_in : 1;
+
+    // Neighbouring lines are at most one pixel apart at outer radius
+    p_gauge->step = (uint16_t)((r_out < ANGLE_RADIAN) ?
+        ANGLE_RADIAN / r_out : 1);
+}
+
+void
+lib_u8g2_GaugeInitBar(lib_u8g2_gauge_t *p_gauge, int16_t x, int16_t y,
+    int16_t w, int16_t h, uint8_t is_vertical, int16_t min, int16_t max)
+{
+    p_gauge->type = (is_vertical) ? LIB_U8G2_GAUGE_VBAR : LIB_U8G2_GAUGE_HBAR;
+    p_gauge->x = x;
+    p_gauge->y = y;
+    p_gauge->w = (w > 2) ? w : 3;
+    p_gauge->h = (h > 2) ? h : 3;
+    p_gauge->r_in = 0;
+    p_gauge->r_out = 0;
+    p_gauge->start = 0;
+    p_gauge->sweep = 0;
+    p_gauge->step = 1;
+    p_gauge->min = min;
+    p_gauge->max = (max > min) ? max : (int16_t)(min + 1);
+    p_gauge->shown = 0;
+}
+
+uint8_t
+lib_u8g2_GaugeDraw(u8g2_t *u8g2, lib_u8g2_gauge_t *p_gauge)
+{
+    int16_t x0 = p_gauge->x;
+    int16_t y0 = p_gauge->y;
+    uint8_t color = u8g2_GetDrawColor(u8g2);
+
+    if (!is_supported(u8g2))
+    {
+        return 0;
+    }
+
+    if ((p_gauge->type == LIB_U8G2_GAUGE_DIAL) ||
+        (p_gauge->type == LIB_U8G2_GAUGE_ARC))
+    {
+        x0 = (int16_t)(x0 - p_gauge->r_out);
+        y0 = (int16_t)(y0 - p_gauge->r_out);
+    }
+
+    lib_u8g2_ClearRegion(u8g2, x0, y0, p_gauge->w, p_gauge->h);
+    lib_u8g2_MarkDirty(u8g2, x0, y0, (int16_t)(x0 + p_gauge->w),
+        (int16_t)(y0 + p_gauge->h));
+
+    u8g2_SetDrawColor(u8g2, 1);
+    switch (p_gauge->type)
+    {
+        case LIB_U8G2_GAUGE_DIAL:
+            for (uint16_t i = 0; i <= LIB_U8G2_GAUGE_DIVISIONS; i++)
+            {
+                draw_radial(u8g2, p_gauge, (uint16_t)(p_gauge->start +
+                    (uint32_t)p_gauge->sweep * i / LIB_U8G2_GAUGE_DIVISIONS),
+                    (int16_t)(p_gauge->r_out - DIAL_TICK), p_gauge->r_out);
+            }
+            draw_needle(u8g2, p_gauge, 1);
+            break;
+
+        case LIB_U8G2_GAUGE_ARC:
+            draw_arc_lines(u8g2, p_gauge, 0, p_gauge->shown);
+            break;
+
+        default:
+            lib_u8g2_DrawFrame(u8g2, (u8g2_uint_t)p_gauge->x,
+                (u8g2_uint_t)p_gauge->y, (u8g2_uint_t)p_gauge->w,
+                (u8g2_uint_t)p_gauge->h);
+            draw_bar(u8g2, p_gauge, 0, p_gauge->shown);
+            break;
+    }
+
+    u8g2_SetDrawColor(u8g2, color);
+
+    return 1;
+}
+
+uint8_t
+lib_u8g2_GaugeSet(u8g2_t *u8g2, lib_u8g2_gauge_t *p_gauge, int16_t value)
+{
+    int16_t pos;
+    int16_t near;
+    uint8_t color = u8g2_GetDrawColor(u8g2);
+
+    if (!is_supported(u8g2))
+    {
+        return 0;
+    }
+
+    pos = gauge_position(p_gauge, value);
+    if (pos == p_gauge->shown)
+    {
+        return 1;
+    }
+
+    switch (p_gauge->type)
+    {
+        case LIB_U8G2_GAUGE_DIAL:
+            draw_needle(u8g2, p_gauge, 0);
+            p_gauge->shown = pos;
+            draw_needle(u8g2, p_gauge, 1);
+            break;
+
+        case LIB_U8G2_GAUGE_ARC:
+            if (pos > p_gauge->shown)
+            {
+                u8g2_SetDrawColor(u8g2, 1);
+                draw_arc_lines(u8g2, p_gauge, p_gauge->shown, pos);
+            }
+            else
+            {
+                u8g2_SetDrawColor(u8g2, 0);
+                draw_arc_lines(u8g2, p_gauge, pos, p_gauge->shown);
+
+                // Lines converge towards center, erased lines share pixels
+                // with filled lines closer than about 1.5 pixels at inner
+                // radius, these are drawn again
+                near = (int16_t)((ANGLE_RADIAN * 3 / 2) /
+                    (p_gauge->r_in * p_gauge->step) + 2);
+                u8g2_SetDrawColor(u8g2, 1);
+                draw_arc_lines(u8g2, p_gauge,
+                    (pos > near) ? (int16_t)(pos - near) : 0, pos);
+
+                // Arc closing to full circle has first lines next to the
+                // erased ones
+                if ((uint32_t)p_gauge->step * (p_gauge->shown - 1 + near) >=
+                    LIB_U8G2_ANGLE_TURN)
+                {
+                    draw_arc_lines(u8g2, p_gauge, 0,
+                        (pos < near) ? pos : near);
+                }
+            }
+            p_gauge->shown = pos;
+            break;
+
+        default:
+            if (pos > p_gauge->shown)
+            {
+                u8g2_SetDrawColor(u8g2, 1);
+                draw_bar(u8g2, p_gauge, p_gauge->shown, pos);
+            }
+            else
+            {
+                u8g2_SetDrawColor(u8g2, 0);
+                draw_bar(u8g2, p_gauge, pos, p_gauge->shown);
+            }
+            p_gauge->shown = pos;
+            break;
+    }
+
+    u8g2_SetDrawColor(u8g2, color);
+
+    return 1;
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static uint8_t
+is_supported(u8g2_t *u8g2)
+{
+    return (uint8_t)(lib_u8g2_IsSpanBuffer(u8g2) &&
+        (u8g2->tile_buf_height == u8x8_GetRows(u8g2_GetU8x8(u8g2))));
+}
+
+static int16_t
+gauge_position(const lib_u8g2_gauge_t *p_gauge, int16_t value)
+{
+    int32_t range = (int32_t)p_gauge->max - p_gauge->min;
+    int32_t span;
+
+    value = (value < p_gauge->min) ? p_gauge->min : value;
+    value = (value > p_gauge->max) ? p_gauge->max : value;
+
+    switch (p_gauge->type)
+    {
+        case LIB_U8G2_GAUGE_DIAL:
+            span = p_gauge->sweep;
+            break;
+
+        case LIB_U8G2_GAUGE_ARC:
+            span = arc_lines(p_gauge);
+            break;
+
+        case LIB_U8G2_GAUGE_HBAR:
+            span = p_gauge->w - 2;
+            break;
+
+        default:
+            span = p_gauge->h - 2;
+            break;
+    }
+
+    // Rounded to nearest position
+    return (int16_t)((((int32_t)value - p_gauge->min) * span + range / 2) /
+        range);
+}
+
+static int16_t
+arc_lines(const lib_u8g2_gauge_t *p_gauge)
+{
+    return (int16_t)(p_gauge->sweep / p_gauge->step + 1);
+}
+
+static void
+draw_radial(u8g2_t *u8g2, const lib_u8g2_gauge_t *p_gauge, uint16_t angle,
+    int16_t r0, int16_t r1)
+{
+    int32_t s = lib_u8g2_Sin(angle);
+    int32_t c = lib_u8g2_Cos(angle);
+
+    // Angle 0 points up, y axis grows down
+    u8g2_DrawLine(u8g2,
+        (u8g2_uint_t)(p_gauge->x + ((r0 * s + 8192) >> 14)),
+        (u8g2_uint_t)(p_gauge->y - ((r0 * c + 8192) >> 14)),
+        (u8g2_uint_t)(p_gauge->x + ((r1 * s + 8192) >> 14)),
+        (u8g2_uint_t)(p_gauge->y - ((r1 * c + 8192) >> 14)));
+}
+
+static void
+draw_arc_lines(u8g2_t *u8g2, const lib_u8g2_gauge_t *p_gauge, int16_t first,
+    int16_t last)
+{
+    for (int16_t i = first; i < last; i++)
+    {
+        draw_radial(u8g2, p_gauge,
+            (uint16_t)(p_gauge->start + (uint32_t)p_gauge->step * i),
+            p_gauge->r_in, p_gauge->r_out);
+    }
+}
+
+static void
+draw_needle(u8g2_t *u8g2, const lib_u8g2_gauge_t *p_gauge, uint8_t color)
+{
+    u8g2_SetDrawColor(u8g2, color);
+    draw_radial(u8g2, p_gauge, (uint16_t)(p_gauge->start + p_gauge->shown),
+        0, (int16_t)(p_gauge->r_out - DIAL_TICK - DIAL_GAP));
+
+    // Hub covers needle base, it is drawn again after needle is erased
+    u8g2_SetDrawColor(u8g2, 1);
+    lib_u8g2_DrawDisc(u8g2, (u8g2_uint_t)p_gauge->x, (u8g2_uint_t)p_gauge->y,
+        DIAL_HUB, U8G2_DRAW_ALL);
+}
+
+static void
+draw_bar(u8g2_t *u8g2, const lib_u8g2_gauge_t *p_gauge, int16_t from,
+    int16_t to)
+{
+    // Bar lengths from and to are measured inside the frame
+    if (p_gauge->type == LIB_U8G2_GAUGE_HBAR)
+    {
+        lib_u8g2_DrawBox(u8g2, (u8g2_uint_t)(p_gauge->x + 1 + from),
+            (u8g2_uint_t)(p_gauge->y + 1), (u8g2_uint_t)(to - from),
+            (u8g2_uint_t)(p_gauge->h - 2));
+    }
+    else
+    {
+        lib_u8g2_DrawBox(u8g2, (u8g2_uint_t)(p_gauge->x + 1),
+            (u8g2_uint_t)(p_gauge->y + p_gauge->h - 1 - to),
+            (u8g2_uint_t)(p_gauge->w - 2), (u8g2_uint_t)(to - from));
+    }
+}
+
+/* [] END OF FILE */
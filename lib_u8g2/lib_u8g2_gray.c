@@ -0,0 +1,288 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_gray.c
+* @version 1.0.0
+*
+* @brief Grayscale images on SSD1306 by frame rate modulation.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <string.h>
+#include <time.h>
+
+#include <lib_u8g2_gray.h>
+#include <lib_u8g2_scroll.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+#define SSD1306_RAM_PAGES           (8)
+#define CMD_SET_START_LINE          (0x40)
+#define CMD_SET_COLUMN_HI           (0x10)
+#define CMD_SET_COLUMN_LO           (0x00)
+#define CMD_SET_PAGE                (0xB0)
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static uint8_t
+frame_plane(uint8_t bits, uint8_t frame);
+
+static void
+send_plane(u8g2_t *u8g2, lib_u8g2_gray_t *p_gray, uint8_t plane,
+    uint8_t ram_page);
+
+static void
+send_diff(u8g2_t *u8g2, lib_u8g2_gray_t *p_gray, uint8_t plane);
+
+static void
+send_ram_page(u8g2_t *u8g2, lib_u8g2_gray_t *p_gray, uint8_t ram_page,
+    const uint8_t *p_data, uint16_t x0, uint16_t x1);
+
+static void
+send_start_line(u8g2_t *u8g2, uint8_t line);
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+uint16_t
+lib_u8g2_GrayPlanesSize(u8g2_t *u8g2, uint8_t bits)
+{
+    return (uint16_t)(bits * u8g2->pixel_buf_width *
+        u8x8_GetRows(u8g2_GetU8x8(u8g2)));
+}
+
+void
+lib_u8g2_GrayPlanesFromLevels(u8g2_t *u8g2, uint8_t *p_planes,
+    const uint8_t *p_levels, uint16_t w, uint16_t h, uint8_t bits)
+{
+    uint16_t width = u8g2->pixel_buf_width;
+    uint16_t plane_size = (uint16_t)(lib_u8g2_GrayPlanesSize(u8g2, bits) /
+        (bits ? bits : 1));
+    uint8_t level;
+    uint8_t mask;
+    uint8_t *p_byte;
+
+    memset(p_planes, 0, (size_t)plane_size * bits);
+
+    for (uint16_t y = 0; y < h; y++)
+    {
+        mask = (uint8_t)(1u << (y & 7));
+        for (uint16_t x = 0; x < w; x++)
+        {
+            level = *p_levels++;
+            p_byte = p_planes + (y >> 3) * width + x;
+            for (uint8_t k = 0; k < bits; k++)
+            {
+                if (level & (1u << k))
+                {
+                    p_byte[k * plane_size] |= mask;
+                }
+            }
+        }
+    }
+}
+
+uint8_t
+lib_u8g2_GrayStart(u8g2_t *u8g2, lib_u8g2_gray_t *p_gray,
+    const uint8_t *p_planes, uint8_t bits)
+{
+    uint8_t rows = u8x8_GetRows(u8g2_GetU8x8(u8g2));
+
+    if ((bits == 0) || (bits > LIB_U8G2_GRAY_MAX_BITS))
+    {
+        return 0;
+    }
+
+    p_gray->p_planes = p_planes;
+    p_gray->plane_size = (uint16_t)(u8g2->pixel_buf_width * rows);
+    p_gray->bits = bits;
+    p_gray->frame = 1;
+    p_gray->plane = frame_plane(bits, 1);
+    p_gray->is_start_line = (uint8_t)(bits * rows <= SSD1306_RAM_PAGES);
+    memset(&p_gray->stats, 0, sizeof(p_gray->stats));
+
+    if (p_gray->is_start_line)
+    {
+        // Plane k is kept in display RAM pages from k * rows, shown plane
+        // is selected by start line
+        for (uint8_t k = 0; k < bits; k++)
+        {
+            send_plane(u8g2, p_gray, k, (uint8_t)(k * rows));
+        }
+        send_start_line(u8g2, (uint8_t)(p_gray->plane * rows * 8));
+    }
+    else
+    {
+        send_start_line(u8g2, 0);
+        send_plane(u8g2, p_gray, p_gray->plane, 0);
+    }
+    p_gray->stats.frames++;
+
+    return 1;
+}
+
+void
+lib_u8g2_GrayStep(u8g2_t *u8g2, lib_u8g2_gray_t *p_gray)
+{
+    uint8_t rows = u8x8_GetRows(u8g2_GetU8x8(u8g2));
+    uint8_t cycle = (uint8_t)((1u << p_gray->bits) - 1);
+    uint8_t plane;
+
+    p_gray->frame = (uint8_t)(p_gray->frame % cycle + 1);
+    plane = frame_plane(p_gray->bits, p_gray->frame);
+
+    if (plane != p_gray->plane)
+    {
+        if (p_gray->is_start_line)
+        {
+            send_start_line(u8g2, (uint8_t)(plane * rows * 8));
+        }
+        else
+        {
+            send_diff(u8g2, p_gray, plane);
+        }
+        p_gray->plane = plane;
+    }
+    p_gray->stats.frames++;
+}
+
+void
+lib_u8g2_GrayStop(u8g2_t *u8g2, lib_u8g2_gray_t *p_gray)
+{
+    if (p_gray->is_start_line && (p_gray->plane != 0))
+    {
+        send_start_line(u8g2, 0);
+    }
+    p_gray->p_planes = NULL;
+}
+
+void
+lib_u8g2_GrayBenchmark(u8g2_t *u8g2, lib_u8g2_gray_t *p_gray,
+    uint32_t frames, lib_u8g2_gray_stats_t *p_stats)
+{
+    struct timespec ts_start;
+    struct timespec ts_end;
+    lib_u8g2_gray_stats_t start = p_gray->stats;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts_start);
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        lib_u8g2_GrayStep(u8g2, p_gray);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &ts_end);
+
+    p_stats->frames = p_gray->stats.frames - start.frames;
+    p_stats->bytes = p_gray->stats.bytes - start.bytes;
+    p_stats->elapsed_us = (uint32_t)(
+        (int64_t)(ts_end.tv_sec - ts_start.tv_sec) * 1000000 +
+        (ts_end.tv_nsec - ts_start.tv_nsec) / 1000);
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static uint8_t
+frame_plane(uint8_t bits, uint8_t frame)
+{
+    uint8_t zeros = 0;
+
+    // Frames 1 to 2^bits - 1 of a cycle, frame with n trailing zero bits
+    // shows plane bits - 1 - n, plane k is then shown in 2^k frames and
+    // frames of each plane are spread evenly over the cycle
+    while ((frame & 1u) == 0)
+    {
+        frame >>= 1;
+        zeros++;
+    }
+
+    return (uint8_t)(bits - 1 - zeros);
+}
+
+static void
+send_plane(u8g2_t *u8g2, lib_u8g2_gray_t *p_gray, uint8_t plane,
+    uint8_t ram_page)
+{
+    uint8_t rows = u8x8_GetRows(u8g2_GetU8x8(u8g2));
+    uint16_t width = u8g2->pixel_buf_width;
+    const uint8_t *p_data = p_gray->p_planes + plane * p_gray->plane_size;
+
+    for (uint8_t page = 0; page < rows; page++)
+    {
+        send_ram_page(u8g2, p_gray, (uint8_t)(ram_page + page),
+            p_data + page * width, 0, width);
+    }
+}
+
+static void
+send_diff(u8g2_t *u8g2, lib_u8g2_gray_t *p_gray, uint8_t plane)
+{
+    uint8_t rows = u8x8_GetRows(u8g2_GetU8x8(u8g2));
+    uint16_t width = u8g2->pixel_buf_width;
+    const uint8_t *p_new = p_gray->p_planes + plane * p_gray->plane_size;
+    const uint8_t *p_old = p_gray->p_planes +
+        p_gray->plane * p_gray->plane_size;
+    uint16_t x0;
+    uint16_t x1;
+
+    for (uint8_t page = 0; page < rows; page++)
+    {
+        // Columns from first to last changed byte of the page are sent in
+        // one transfer, single commands setting address cost more than
+        // a few unchanged bytes
+        x0 = 0;
+        while ((x0 < width) && (p_new[x0] == p_old[x0]))
+        {
+            x0++;
+        }
+        if (x0 < width)
+        {
+            x1 = width;
+            while (p_new[x1 - 1] == p_old[x1 - 1])
+            {
+                x1--;
+            }
+            send_ram_page(u8g2, p_gray, page, p_new, x0, x1);
+        }
+        p_new += width;
+        p_old += width;
+    }
+}
+
+static void
+send_ram_page(u8g2_t *u8g2, lib_u8g2_gray_t *p_gray, uint8_t ram_page,
+    const uint8_t *p_data, uint16_t x0, uint16_t x1)
+{
+    u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+    uint8_t col = (uint8_t)(x0 + u8x8->x_offset);
+
+    // Display RAM is addressed directly, u8x8_DrawTile() cannot reach pages
+    // below visible display
+    u8x8_cad_StartTransfer(u8x8);
+    u8x8_cad_SendCmd(u8x8, (uint8_t)(CMD_SET_COLUMN_HI | (col >> 4)));
+    u8x8_cad_SendArg(u8x8, (uint8_t)(CMD_SET_COLUMN_LO | (col & 0x0F)));
+    u8x8_cad_SendArg(u8x8, (uint8_t)(CMD_SET_PAGE | ram_page));
+    u8x8_cad_SendData(u8x8, (uint8_t)(x1 - x0), (uint8_t *)(p_data + x0));
+    u8x8_cad_EndTransfer(u8x8);
+
+    p_gray->stats.bytes += (uint32_t)(x1 - x0);
+}
+
+static void
+send_start_line(u8g2_t *u8g2, uint8_t line)
+{
+    u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+
+    u8x8_cad_StartTransfer(u8x8);
+    u8x8_cad_SendCmd(u8x8, (uint8_t)(CMD_SET_START_LINE | line));
+    u8x8_cad_EndTransfer(u8x8);
+
+    lib_u8g2_SetStartLine(line);
+}
+
+/* [] END OF FILE */
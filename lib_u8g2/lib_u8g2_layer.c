@@ -0,0 +1,284 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_layer.c
+* @version 1.0.0
+*
+* @brief Layered frame buffer compositing.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include <lib_u8g2_layer.h>
+#include <lib_u8g2_span.h>
+#include <lib_u8g2_dirty.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+// Word type used by compositing, may alias buffer bytes
+#if defined(__LP64__) || defined(_WIN64)
+typedef uint64_t blend_word_base_t;
+#else
+typedef uint32_t blend_word_base_t;
+#endif
+
+#ifdef __GNUC__
+typedef blend_word_base_t __attribute__((__may_alias__)) blend_word_t;
+#else
+typedef blend_word_base_t blend_word_t;
+#endif
+
+/*******************************************************************************
+* Private types
+*******************************************************************************/
+
+typedef struct
+{
+    uint8_t *p_buf;
+    lib_u8g2_blend_t blend;
+    uint8_t is_visible;
+} layer_t;
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static void
+composite(size_t offset, size_t len);
+
+static void
+blend_bytes(uint8_t *p_dst, const uint8_t *p_src, size_t len,
+    lib_u8g2_blend_t blend);
+
+static uint8_t
+blend_byte(uint8_t dst, uint8_t src, lib_u8g2_blend_t blend);
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+
+static uint8_t *g_send_buf;     // u8g2 frame buffer holding composite
+static layer_t g_layers[LIB_U8G2_LAYER_MAX];
+static uint8_t g_layer_cnt;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void
+lib_u8g2_LayerInit(u8g2_t *u8g2)
+{
+    // Repeated init while a layer is selected gives back composite buffer,
+    // any other buffer of the display becomes composite buffer
+    for (uint8_t i = 0; i < g_layer_cnt; i++)
+    {
+        if (u8g2->tile_buf_ptr == g_layers[i].p_buf)
+        {
+            u8g2->tile_buf_ptr = g_send_buf;
+            break;
+        }
+    }
+
+    g_send_buf = u8g2->tile_buf_ptr;
+    g_layer_cnt = 0;
+}
+
+uint8_t
+lib_u8g2_LayerAdd(u8g2_t *u8g2, uint8_t *p_buf, lib_u8g2_blend_t blend)
+{
+    if (g_layer_cnt >= LIB_U8G2_LAYER_MAX)
+    {
+        return LIB_U8G2_LAYER_NONE;
+    }
+
+    memset(p_buf, 0, (size_t)u8g2->tile_buf_height * u8g2->pixel_buf_width);
+
+    g_layers[g_layer_cnt].p_buf = p_buf;
+    g_layers[g_layer_cnt].blend = blend;
+    g_layers[g_layer_cnt].is_visible = 1;
+
+    return g_layer_cnt++;
+}
+
+void
+lib_u8g2_LayerSelect(u8g2_t *u8g2, uint8_t layer)
+{
+    if (layer < g_layer_cnt)
+    {
+        u8g2->tile_buf_ptr = g_layers[layer].p_buf;
+    }
+}
+
+void
+lib_u8g2_LayerSetVisible(u8g2_t *u8g2, uint8_t layer, uint8_t is_visible)
+{
+    if ((layer < g_layer_cnt) && (g_layers[layer].is_visible != is_visible))
+    {
+        g_layers[layer].is_visible = is_visible;
+        lib_u8g2_MarkDirty(u8g2, 0, 0, (int16_t)u8g2_GetDisplayWidth(u8g2),
+            (int16_t)u8g2_GetDisplayHeight(u8g2));
+    }
+}
+
+uint8_t
+lib_u8g2_LayerSend(u8g2_t *u8g2)
+{
+    uint8_t *p_draw_buf = u8g2->tile_buf_ptr;
+    size_t width = u8g2->pixel_buf_width;
+    size_t col0;
+    size_t col1;
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+    uint8_t result;
+
+    if (g_layer_cnt == 0)
+    {
+        return lib_u8g2_SendDirty(u8g2);
+    }
+
+    if (!lib_u8g2_GetDirtyArea(u8g2, &x0, &y0, &x1, &y1))
+    {
+        return 0;
+    }
+
+    if (lib_u8g2_IsSpanBuffer(u8g2))
+    {
+        // Tile columns of dirty area in each page
+        col0 = (size_t)(x0 / 8) * 8;
+        col1 = (size_t)((x1 + 7) / 8) * 8;
+        if (col1 > width)
+        {
+            col1 = width;
+        }
+
+        for (int16_t page = (int16_t)(y0 / 8); page < (y1 + 7) / 8; page++)
+        {
+            composite((size_t)page * width + col0, col1 - col0);
+        }
+    }
+    else
+    {
+        composite(0, (size_t)u8g2->tile_buf_height * width);
+    }
+
+    u8g2->tile_buf_ptr = g_send_buf;
+    result = lib_u8g2_SendDirty(u8g2);
+    u8g2->tile_buf_ptr = p_draw_buf;
+
+    return result;
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static void
+composite(size_t offset, size_t len)
+{
+    uint8_t *p_dst = g_send_buf + offset;
+    uint8_t is_first = 1;
+
+    for (uint8_t i = 0; i < g_layer_cnt; i++)
+    {
+        if (!g_layers[i].is_visible)
+        {
+            continue;
+        }
+
+        if (is_first)
+        {
+            memcpy(p_dst, g_layers[i].p_buf + offset, len);
+            is_first = 0;
+        }
+        else
+        {
+            blend_bytes(p_dst, g_layers[i].p_buf + offset, len,
+                g_layers[i].blend);
+        }
+    }
+
+    if (is_first)
+    {
+        // No visible layer
+        memset(p_dst, 0, len);
+    }
+}
+
+static void
+blend_bytes(uint8_t *p_dst, const uint8_t *p_src, size_t len,
+    lib_u8g2_blend_t blend)
+{
+    blend_word_t *p_dst_word;
+    const blend_word_t *p_src_word;
+
+    // Bytes up to word aligned destination
+    while ((len > 0) &&
+        (((uintptr_t)p_dst & (sizeof(blend_word_t) - 1)) != 0))
+    {
+        *p_dst = blend_byte(*p_dst, *p_src, blend);
+        p_dst++;
+        p_src++;
+        len--;
+    }
+
+    if (((uintptr_t)p_src & (sizeof(blend_word_t) - 1)) == 0)
+    {
+        p_dst_word = (blend_word_t *)(void *)p_dst;
+        p_src_word = (const blend_word_t *)(const void *)p_src;
+
+        switch (blend)
+        {
+        case LIB_U8G2_BLEND_OR:
+            for (; len >= sizeof(blend_word_t); len -= sizeof(blend_word_t))
+            {
+                *p_dst_word++ |= *p_src_word++;
+            }
+            break;
+        case LIB_U8G2_BLEND_AND_NOT:
+            for (; len >= sizeof(blend_word_t); len -= sizeof(blend_word_t))
+            {
+                *p_dst_word++ &= ~*p_src_word++;
+            }
+            break;
+        default:
+            for (; len >= sizeof(blend_word_t); len -= sizeof(blend_word_t))
+            {
+                *p_dst_word++ ^= *p_src_word++;
+            }
+            break;
+        }
+
+        p_dst = (uint8_t *)p_dst_word;
+        p_src = (const uint8_t *)p_src_word;
+    }
+
+    // Remaining bytes, or all bytes of differently aligned buffers
+    for (; len > 0; len--)
+    {
+        *p_dst = blend_byte(*p_dst, *p_src, blend);
+        p_dst++;
+        p_src++;
+    }
+}
+
+static uint8_t
+blend_byte(uint8_t dst, uint8_t src, lib_u8g2_blend_t blend)
+{
+    switch (blend)
+    {
+    case LIB_U8G2_BLEND_OR:
+        return (uint8_t)(dst | src);
+    case LIB_U8G2_BLEND_AND_NOT:
+        return (uint8_t)(dst & ~src);
+    default:
+        return (uint8_t)(dst ^ src);
+    }
+}
+
+/* [] END OF FILE */
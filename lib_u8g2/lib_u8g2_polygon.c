@@ -0,0 +1,417 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_polygon.c
+* @version 1.0.0
+*
+* @brief Scanline polygon filler with active edge table.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <time.h>
+
+#include <lib_u8g2_polygon.h>
+#include <lib_u8g2_span.h>
+#include <lib_u8g2_dirty.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+#define FIXED_SHIFT             (16)
+#define FIXED_ONE               (1L << FIXED_SHIFT)
+#define FIXED_HALF              (1L << (FIXED_SHIFT - 1))
+
+// Benchmark gauges in 4 x 2 grid, needle length and half width
+#define BENCH_GAUGES            (8u)
+#define BENCH_CELL              (32)
+#define BENCH_NEEDLE_LEN        (14)
+#define BENCH_NEEDLE_WIDTH      (3)
+#define BENCH_NEEDLE_POINTS     (4u)
+
+/*******************************************************************************
+* Private types
+*******************************************************************************/
+
+typedef struct
+{
+    int16_t x_start;    // First column crossed by edge
+    int16_t x_end;      // Column after the last one crossed by edge
+    int32_t y;          // Intersection with current column center, 16.16
+    int32_t dy;         // Intersection step per column, 16.16
+    int8_t winding;     // +1 for edges going right, -1 going left
+} edge_t;
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static void
+add_polygon(const lib_u8g2_polygon_t *p_polygon, int16_t page_y0,
+    int16_t page_y1);
+
+static void
+fill_edges(u8g2_t *u8g2);
+
+static void
+bench_needles(lib_u8g2_point_t *points, int32_t ux, int32_t uy);
+
+static uint32_t
+elapsed_us(const struct timespec *p_start);
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+
+static edge_t g_edges[LIB_U8G2_POLYGON_MAX_EDGES];     // Edge table
+static edge_t *g_active[LIB_U8G2_POLYGON_MAX_EDGES];   // Active edge table
+static uint8_t g_edge_cnt;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+uint8_t
+lib_u8g2_FillPolygons(u8g2_t *u8g2, const lib_u8g2_polygon_t *polygons,
+    uint8_t count)
+{
+    int16_t page_y0 = 0;
+    int16_t page_y1 = (int16_t)u8g2_GetDisplayHeight(u8g2);
+    uint8_t is_complete = 1;
+
+    if (lib_u8g2_IsSpanBuffer(u8g2))
+    {
+        // Rows covered by current page
+        page_y0 = (int16_t)u8g2->user_y0;
+        page_y1 = (int16_t)u8g2->user_y1;
+    }
+
+    g_edge_cnt = 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (polygons[i].count > LIB_U8G2_POLYGON_MAX_EDGES)
+        {
+            is_complete = 0;
+            continue;
+        }
+
+        if (g_edge_cnt + polygons[i].count > LIB_U8G2_POLYGON_MAX_EDGES)
+        {
+            // Edge table full, flush polygons collected so far
+            fill_edges(u8g2);
+            g_edge_cnt = 0;
+        }
+
+        add_polygon(&polygons[i], page_y0, page_y1);
+    }
+
+    fill_edges(u8g2);
+
+    return is_complete;
+}
+
+uint8_t
+lib_u8g2_FillPolygon(u8g2_t *u8g2, const lib_u8g2_point_t *points,
+    uint8_t count)
+{
+    lib_u8g2_polygon_t polygon = { points, count };
+
+    return lib_u8g2_FillPolygons(u8g2, &polygon, 1);
+}
+
+void
+lib_u8g2_PolygonBenchmark(u8g2_t *u8g2, uint32_t frames,
+    lib_u8g2_bench_t *p_result)
+{
+    lib_u8g2_point_t points[BENCH_GAUGES * BENCH_NEEDLE_POINTS];
+    lib_u8g2_polygon_t polygons[BENCH_GAUGES];
+    struct timespec ts_start;
+    int32_t ux;
+    int32_t uy;
+
+    for (uint8_t i = 0; i < BENCH_GAUGES; i++)
+    {
+        polygons[i].points = points + i * BENCH_NEEDLE_POINTS;
+        polygons[i].count = BENCH_NEEDLE_POINTS;
+    }
+    u8g2_SetDrawColor(u8g2, 1);
+
+    // Neither run records dirty areas, whole buffer is marked dirty
+    // afterwards
+    lib_u8g2_PauseDirty(1);
+
+    // Needle direction is a vector of length 256 rotated by about 3.6
+    // degrees per frame, both runs draw the same sequence
+    ux = 0;
+    uy = -256;
+    clock_gettime(CLOCK_MONOTONIC, &ts_start);
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        ux -= uy / 16;
+        uy += ux / 16;
+        bench_needles(points, ux, uy);
+        u8g2_ClearBuffer(u8g2);
+        for (uint8_t i = 0; i < BENCH_GAUGES; i++)
+        {
+            u8g2_ClearPolygonXY();
+            for (uint8_t k = 0; k < BENCH_NEEDLE_POINTS; k++)
+            {
+                u8g2_AddPolygonXY(u8g2, polygons[i].points[k].x,
+                    polygons[i].points[k].y);
+            }
+            u8g2_DrawPolygon(u8g2);
+        }
+    }
+    p_result->u8g2_us = elapsed_us(&ts_start);
+
+    ux = 0;
+    uy = -256;
+    clock_gettime(CLOCK_MONOTONIC, &ts_start);
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        ux -= uy / 16;
+        uy += ux / 16;
+        bench_needles(points, ux, uy);
+        u8g2_ClearBuffer(u8g2);
+        lib_u8g2_FillPolygons(u8g2, polygons, BENCH_GAUGES);
+    }
+    p_result->lib_us = elapsed_us(&ts_start);
+
+    lib_u8g2_PauseDirty(0);
+    u8g2_ClearBuffer(u8g2);
+    lib_u8g2_MarkDirty(u8g2, 0, 0, (int16_t)u8g2_GetDisplayWidth(u8g2),
+        (int16_t)u8g2_GetDisplayHeight(u8g2));
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static void
+bench_needles(lib_u8g2_point_t *points, int32_t ux, int32_t uy)
+{
+    int16_t cx;
+    int16_t cy;
+
+    // Kite shaped needle: tip, side, short tail, other side
+    for (uint8_t i = 0; i < BENCH_GAUGES; i++)
+    {
+        cx = (int16_t)((i % 4) * BENCH_CELL + BENCH_CELL / 2);
+        cy = (int16_t)((i / 4) * BENCH_CELL + BENCH_CELL / 2);
+        points[0].x = (int16_t)(cx + ux * BENCH_NEEDLE_LEN / 256);
+        points[0].y = (int16_t)(cy + uy * BENCH_NEEDLE_LEN / 256);
+        points[1].x = (int16_t)(cx - uy * BENCH_NEEDLE_WIDTH / 256);
+        points[1].y = (int16_t)(cy + ux * BENCH_NEEDLE_WIDTH / 256);
+        points[2].x = (int16_t)(cx - ux * BENCH_NEEDLE_LEN / 4 / 256);
+        points[2].y = (int16_t)(cy - uy * BENCH_NEEDLE_LEN / 4 / 256);
+        points[3].x = (int16_t)(cx + uy * BENCH_NEEDLE_WIDTH / 256);
+        points[3].y = (int16_t)(cy - ux * BENCH_NEEDLE_WIDTH / 256);
+        points += BENCH_NEEDLE_POINTS;
+    }
+}
+
+static uint32_t
+elapsed_us(const struct timespec *p_start)
+{
+    struct timespec ts_end;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts_end);
+
+    return (uint32_t)((int64_t)(ts_end.tv_sec - p_start->tv_sec) * 1000000 +
+        (ts_end.tv_nsec - p_start->tv_nsec) / 1000);
+}
+
+static void
+add_polygon(const lib_u8g2_polygon_t *p_polygon, int16_t page_y0,
+    int16_t page_y1)
+{
+    const lib_u8g2_point_t *p0;
+    const lib_u8g2_point_t *p1;
+    edge_t tmp;
+    int16_t y_min;
+    int16_t y_max;
+    int32_t dx;
+    int32_t area = 0;
+    int8_t orientation;
+    int8_t pos;
+
+    if (p_polygon->count < 3)
+    {
+        return;
+    }
+
+    // Skip polygons outside of current page
+    y_min = p_polygon->points[0].y;
+    y_max = y_min;
+    for (uint8_t i = 1; i < p_polygon->count; i++)
+    {
+        if (p_polygon->points[i].y < y_min)
+        {
+            y_min = p_polygon->points[i].y;
+        }
+        if (p_polygon->points[i].y > y_max)
+        {
+            y_max = p_polygon->points[i].y;
+        }
+    }
+    if ((y_max < page_y0) || (y_min >= page_y1))
+    {
+        return;
+    }
+
+    // Union of batch needs the same winding direction for all polygons
+    for (uint8_t i = 0; i < p_polygon->count; i++)
+    {
+        p0 = &p_polygon->points[i];
+        p1 = &p_polygon->points[(i + 1 == p_polygon->count) ? 0 : i + 1];
+        area += (int32_t)p0->x * p1->y - (int32_t)p1->x * p0->y;
+    }
+    orientation = (area < 0) ? -1 : 1;
+
+    for (uint8_t i = 0; i < p_polygon->count; i++)
+    {
+        p0 = &p_polygon->points[i];
+        p1 = &p_polygon->points[(i + 1 == p_polygon->count) ? 0 : i + 1];
+
+        if (p0->x == p1->x)
+        {
+            // Vertical edges never cross a column center
+            continue;
+        }
+
+        if (p0->x < p1->x)
+        {
+            tmp.winding = orientation;
+        }
+        else
+        {
+            const lib_u8g2_point_t *p_swap = p0;
+            p0 = p1;
+            p1 = p_swap;
+            tmp.winding = (int8_t)-orientation;
+        }
+
+        // Edge crosses centers of columns x_start .. x_end - 1, intersection
+        // is evaluated at column center x + 0.5
+        dx = (int32_t)p1->x - p0->x;
+        tmp.x_start = p0->x;
+        tmp.x_end = p1->x;
+        tmp.dy = (int32_t)(((int64_t)(p1->y - p0->y) * FIXED_ONE) / dx);
+        tmp.y = (int32_t)((int64_t)p0->y * FIXED_ONE +
+            ((int64_t)(p1->y - p0->y) * FIXED_ONE) / (2 * dx));
+
+        // Insert sorted by first column
+        pos = (int8_t)g_edge_cnt;
+        while ((pos > 0) && (g_edges[pos - 1].x_start > tmp.x_start))
+        {
+            g_edges[pos] = g_edges[pos - 1];
+            pos--;
+        }
+        g_edges[pos] = tmp;
+        g_edge_cnt++;
+    }
+}
+
+static void
+fill_edges(u8g2_t *u8g2)
+{
+    lib_u8g2_span_t span;
+    uint8_t next = 0;       // Next edge of edge table to be activated
+    uint8_t active_cnt = 0;
+    int16_t x;
+    int16_t x_last;
+    int16_t width = (int16_t)u8g2_GetDisplayWidth(u8g2);
+    int16_t y0;
+    int16_t y1;
+    int winding;
+
+    if (g_edge_cnt == 0)
+    {
+        return;
+    }
+
+    lib_u8g2_SpanBegin(&span, u8g2);
+
+    x = (g_edges[0].x_start < 0) ? 0 : g_edges[0].x_start;
+    x_last = g_edges[0].x_end;
+    for (uint8_t i = 1; i < g_edge_cnt; i++)
+    {
+        if (g_edges[i].x_end > x_last)
+        {
+            x_last = g_edges[i].x_end;
+        }
+    }
+    if (x_last > width)
+    {
+        x_last = width;
+    }
+
+    for (; x < x_last; x++)
+    {
+        // Activate edges reaching this column, edges starting left of the
+        // display are advanced to it
+        while ((next < g_edge_cnt) && (g_edges[next].x_start <= x))
+        {
+            edge_t *p_edge = &g_edges[next++];
+
+            if (p_edge->x_end <= x)
+            {
+                continue;
+            }
+            p_edge->y = (int32_t)(p_edge->y +
+                (int64_t)p_edge->dy * (x - p_edge->x_start));
+            g_active[active_cnt++] = p_edge;
+        }
+
+        // Drop finished edges, keep active edges sorted by intersection
+        for (uint8_t i = 0; i < active_cnt; )
+        {
+            if (g_active[i]->x_end <= x)
+            {
+                for (uint8_t j = i; j + 1 < active_cnt; j++)
+                {
+                    g_active[j] = g_active[j + 1];
+                }
+                active_cnt--;
+                continue;
+            }
+
+            for (uint8_t j = i; (j > 0) && (g_active[j - 1]->y > g_active[j]->y);
+                j--)
+            {
+                edge_t *p_swap = g_active[j];
+                g_active[j] = g_active[j - 1];
+                g_active[j - 1] = p_swap;
+            }
+            i++;
+        }
+
+        // Fill rows whose centers lie in spans of non-zero winding
+        winding = 0;
+        for (uint8_t i = 0; i < active_cnt; i++)
+        {
+            if (winding == 0)
+            {
+                y0 = (int16_t)((g_active[i]->y + FIXED_HALF - 1) >> FIXED_SHIFT);
+            }
+
+            winding += g_active[i]->winding;
+
+            if (winding == 0)
+            {
+                y1 = (int16_t)((g_active[i]->y + FIXED_HALF - 1) >> FIXED_SHIFT);
+                if (y1 > y0)
+                {
+                    lib_u8g2_SpanFill(&span, x, y0, (int16_t)(x + 1), y1);
+                }
+            }
+        }
+
+        for (uint8_t i = 0; i < active_cnt; i++)
+        {
+            g_active[i]->y += g_active[i]->dy;
+        }
+    }
+}
+
+/* [] END OF FILE */
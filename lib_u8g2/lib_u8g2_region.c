@@ -0,0 +1,487 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_region.c
+* @version 1.0.0
+*
+* @brief Copying and scrolling of frame buffer regions.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <lib_u8g2_region.h>
+#include <lib_u8g2_span.h>
+#include <lib_u8g2_dirty.h>
+
+/*******************************************************************************
+* Private types
+*******************************************************************************/
+
+// Stored after tile data of saved region
+typedef struct
+{
+    uint8_t tx;
+    uint8_t ty;
+    uint8_t tw;
+    uint8_t th;
+} region_header_t;
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static uint8_t
+page_mask(int16_t page, int16_t y0, int16_t y1);
+
+static uint8_t
+column_byte(u8g2_t *u8g2, int16_t x, int16_t row);
+
+static void
+copy_aligned(u8g2_t *u8g2, int16_t src_x, int16_t src_y, int16_t w,
+    int16_t h, int16_t dst_x, int16_t dst_y);
+
+static void
+copy_shifted(u8g2_t *u8g2, int16_t src_x, int16_t src_y, int16_t w,
+    int16_t h, int16_t dst_x, int16_t dst_y);
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+
+static uint8_t g_stack[LIB_U8G2_REGION_STACK_SIZE];
+static size_t g_stack_len;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+uint8_t
+lib_u8g2_CopyRegion(u8g2_t *u8g2, int16_t src_x, int16_t src_y, int16_t w,
+    int16_t h, int16_t dst_x, int16_t dst_y)
+{
+    int16_t width = (int16_t)u8g2->pixel_buf_width;
+    int16_t height = (int16_t)(u8g2->tile_buf_height * 8);
+
+    if (!lib_u8g2_IsSpanBuffer(u8g2))
+    {
+        return 0;
+    }
+
+    // Buffer coordinates
+    src_y = (int16_t)(src_y - (int16_t)u8g2->pixel_curr_row);
+    dst_y = (int16_t)(dst_y - (int16_t)u8g2->pixel_curr_row);
+
+    // Clip both rectangles to buffer
+    if (src_x < 0)
+    {
+        w = (int16_t)(w + src_x);
+        dst_x = (int16_t)(dst_x - src_x);
+        src_x = 0;
+    }
+    if (dst_x < 0)
+    {
+        w = (int16_t)(w + dst_x);
+        src_x = (int16_t)(src_x - dst_x);
+        dst_x = 0;
+    }
+    if (src_y < 0)
+    {
+        h = (int16_t)(h + src_y);
+        dst_y = (int16_t)(dst_y - src_y);
+        src_y = 0;
+    }
+    if (dst_y < 0)
+    {
+        h = (int16_t)(h + dst_y);
+        src_y = (int16_t)(src_y - dst_y);
+        dst_y = 0;
+    }
+    if (src_x + w > width)
+    {
+        w = (int16_t)(width - src_x);
+    }
+    if (dst_x + w > width)
+    {
+        w = (int16_t)(width - dst_x);
+    }
+    if (src_y + h > height)
+    {
+        h = (int16_t)(height - src_y);
+    }
+    if (dst_y + h > height)
+    {
+        h = (int16_t)(height - dst_y);
+    }
+
+    if ((w <= 0) || (h <= 0) || ((src_x == dst_x) && (src_y == dst_y)))
+    {
+        return 1;
+    }
+
+    lib_u8g2_MarkDirty(u8g2, dst_x, (int16_t)(dst_y + u8g2->pixel_curr_row),
+        (int16_t)(dst_x + w), (int16_t)(dst_y + h + u8g2->pixel_curr_row));
+
+    if ((dst_y - src_y) % 8 == 0)
+    {
+        copy_aligned(u8g2, src_x, src_y, w, h, dst_x, dst_y);
+    }
+    else
+    {
+        copy_shifted(u8g2, src_x, src_y, w, h, dst_x, dst_y);
+    }
+
+    return 1;
+}
+
+uint8_t
+lib_u8g2_ScrollRegion(u8g2_t *u8g2, int16_t x, int16_t y, int16_t w,
+    int16_t h, int16_t dx, int16_t dy)
+{
+    int16_t width = (int16_t)u8g2->pixel_buf_width;
+    int16_t top = (int16_t)u8g2->pixel_curr_row;
+    int16_t bottom = (int16_t)(top + u8g2->tile_buf_height * 8);
+
+    if (!lib_u8g2_IsSpanBuffer(u8g2))
+    {
+        return 0;
+    }
+
+    // Only content held in buffer is scrolled, rectangle is clipped first
+    // so that exposed strips lie at edges of the visible part
+    if (x < 0)
+    {
+        w = (int16_t)(w + x);
+        x = 0;
+    }
+    if (x + w > width)
+    {
+        w = (int16_t)(width - x);
+    }
+    if (y < top)
+    {
+        h = (int16_t)(h - (top - y));
+        y = top;
+    }
+    if (y + h > bottom)
+    {
+        h = (int16_t)(bottom - y);
+    }
+    if ((w <= 0) || (h <= 0))
+    {
+        return 1;
+    }
+
+    if ((abs(dx) >= w) || (abs(dy) >= h))
+    {
+        return lib_u8g2_ClearRegion(u8g2, x, y, w, h);
+    }
+
+    lib_u8g2_CopyRegion(u8g2,
+        (int16_t)(x + ((dx < 0) ? -dx : 0)), (int16_t)(y + ((dy < 0) ? -dy : 0)),
+        (int16_t)(w - abs(dx)), (int16_t)(h - abs(dy)),
+        (int16_t)(x + ((dx > 0) ? dx : 0)), (int16_t)(y + ((dy > 0) ? dy : 0)));
+
+    // Exposed strips
+    if (dx > 0)
+    {
+        lib_u8g2_ClearRegion(u8g2, x, y, dx, h);
+    }
+    else if (dx < 0)
+    {
+        lib_u8g2_ClearRegion(u8g2, (int16_t)(x + w + dx), y, (int16_t)-dx, h);
+    }
+
+    if (dy > 0)
+    {
+        lib_u8g2_ClearRegion(u8g2, x, y, w, dy);
+    }
+    else if (dy < 0)
+    {
+        lib_u8g2_ClearRegion(u8g2, x, (int16_t)(y + h + dy), w, (int16_t)-dy);
+    }
+
+    return 1;
+}
+
+uint8_t
+lib_u8g2_ClearRegion(u8g2_t *u8g2, int16_t x, int16_t y, int16_t w,
+    int16_t h)
+{
+    int16_t width = (int16_t)u8g2->pixel_buf_width;
+    int16_t height = (int16_t)(u8g2->tile_buf_height * 8);
+    int16_t x1;
+    int16_t y1;
+    uint8_t *ptr;
+    uint8_t mask;
+
+    if (!lib_u8g2_IsSpanBuffer(u8g2))
+    {
+        return 0;
+    }
+
+    y = (int16_t)(y - (int16_t)u8g2->pixel_curr_row);
+    x1 = (int16_t)(x + w);
+    y1 = (int16_t)(y + h);
+    if (x < 0)
+    {
+        x = 0;
+    }
+    if (y < 0)
+    {
+        y = 0;
+    }
+    if (x1 > width)
+    {
+        x1 = width;
+    }
+    if (y1 > height)
+    {
+        y1 = height;
+    }
+    if ((x >= x1) || (y >= y1))
+    {
+        return 1;
+    }
+
+    lib_u8g2_MarkDirty(u8g2, x, (int16_t)(y + u8g2->pixel_curr_row), x1,
+        (int16_t)(y1 + u8g2->pixel_curr_row));
+
+    for (int16_t page = (int16_t)(y >> 3); page <= ((y1 - 1) >> 3); page++)
+    {
+        ptr = u8g2->tile_buf_ptr + (size_t)page * u8g2->pixel_buf_width + x;
+        mask = page_mask(page, y, y1);
+        if (mask == 0xFF)
+        {
+            memset(ptr, 0, (size_t)(x1 - x));
+        }
+        else
+        {
+            for (int16_t i = 0; i < x1 - x; i++)
+            {
+                ptr[i] = (uint8_t)(ptr[i] & ~mask);
+            }
+        }
+    }
+
+    return 1;
+}
+
+uint8_t
+lib_u8g2_PushRegion(u8g2_t *u8g2, int16_t x, int16_t y, int16_t w,
+    int16_t h)
+{
+    int16_t width = (int16_t)u8g2->pixel_buf_width;
+    int16_t height = (int16_t)(u8g2->tile_buf_height * 8);
+    region_header_t header;
+    size_t row_len;
+    int16_t x1 = (int16_t)(x + w);
+    int16_t y1 = (int16_t)(y + h);
+
+    if (!lib_u8g2_IsSpanBuffer(u8g2) ||
+        (u8g2->tile_buf_height != u8x8_GetRows(u8g2_GetU8x8(u8g2))))
+    {
+        return 0;
+    }
+
+    if (x < 0)
+    {
+        x = 0;
+    }
+    if (y < 0)
+    {
+        y = 0;
+    }
+    if (x1 > width)
+    {
+        x1 = width;
+    }
+    if (y1 > height)
+    {
+        y1 = height;
+    }
+    if ((x >= x1) || (y >= y1))
+    {
+        // Empty region is pushed to keep push and pop calls paired
+        x = 0;
+        y = 0;
+        x1 = 0;
+        y1 = 0;
+    }
+
+    header.tx = (uint8_t)(x / 8);
+    header.ty = (uint8_t)(y / 8);
+    header.tw = (uint8_t)((x1 + 7) / 8 - header.tx);
+    header.th = (uint8_t)((y1 + 7) / 8 - header.ty);
+    row_len = (size_t)header.tw * 8;
+
+    if (g_stack_len + row_len * header.th + sizeof(header) > sizeof(g_stack))
+    {
+        return 0;
+    }
+
+    for (uint8_t ty = header.ty; ty < header.ty + header.th; ty++)
+    {
+        memcpy(g_stack + g_stack_len, u8g2->tile_buf_ptr +
+            (size_t)ty * u8g2->pixel_buf_width + header.tx * 8u, row_len);
+        g_stack_len += row_len;
+    }
+
+    memcpy(g_stack + g_stack_len, &header, sizeof(header));
+    g_stack_len += sizeof(header);
+
+    return 1;
+}
+
+uint8_t
+lib_u8g2_PopRegion(u8g2_t *u8g2)
+{
+    region_header_t header;
+    size_t row_len;
+
+    if (g_stack_len < sizeof(header))
+    {
+        return 0;
+    }
+
+    g_stack_len -= sizeof(header);
+    memcpy(&header, g_stack + g_stack_len, sizeof(header));
+    row_len = (size_t)header.tw * 8;
+    g_stack_len -= row_len * header.th;
+
+    for (uint8_t i = 0; i < header.th; i++)
+    {
+        memcpy(u8g2->tile_buf_ptr + (size_t)(header.ty + i) *
+            u8g2->pixel_buf_width + header.tx * 8u,
+            g_stack + g_stack_len + row_len * i, row_len);
+    }
+
+    lib_u8g2_MarkDirty(u8g2, (int16_t)(header.tx * 8),
+        (int16_t)(header.ty * 8), (int16_t)((header.tx + header.tw) * 8),
+        (int16_t)((header.ty + header.th) * 8));
+
+    return 1;
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static uint8_t
+page_mask(int16_t page, int16_t y0, int16_t y1)
+{
+    // Rows y0 <= y < y1 lying in given page
+    uint8_t mask = 0xFF;
+
+    if (page == (y0 >> 3))
+    {
+        mask = (uint8_t)(mask << (y0 & 7));
+    }
+    if (page == ((y1 - 1) >> 3))
+    {
+        mask = (uint8_t)(mask & (0xFFu >> (7 - ((y1 - 1) & 7))));
+    }
+
+    return mask;
+}
+
+static uint8_t
+column_byte(u8g2_t *u8g2, int16_t x, int16_t row)
+{
+    // Eight rows starting at given row, rows outside of buffer are empty
+    int16_t page_cnt = (int16_t)u8g2->tile_buf_height;
+    int16_t page = (int16_t)((row + 8 * 256) / 8 - 256);
+    uint8_t bit = (uint8_t)((row + 8 * 256) % 8);
+    uint16_t value = 0;
+
+    if ((page >= 0) && (page < page_cnt))
+    {
+        value = u8g2->tile_buf_ptr[(size_t)page * u8g2->pixel_buf_width + x];
+    }
+    if ((page + 1 >= 0) && (page + 1 < page_cnt))
+    {
+        value = (uint16_t)(value |
+            (u8g2->tile_buf_ptr[(size_t)(page + 1) * u8g2->pixel_buf_width + x]
+            << 8));
+    }
+
+    return (uint8_t)(value >> bit);
+}
+
+static void
+copy_aligned(u8g2_t *u8g2, int16_t src_x, int16_t src_y, int16_t w,
+    int16_t h, int16_t dst_x, int16_t dst_y)
+{
+    int16_t page_first = (int16_t)(dst_y >> 3);
+    int16_t page_last = (int16_t)((dst_y + h - 1) >> 3);
+    int16_t page_shift = (int16_t)((dst_y - src_y) / 8);
+    int16_t page;
+    uint8_t *dst;
+    uint8_t *src;
+    uint8_t mask;
+
+    // Moving down processes pages bottom up not to overwrite source
+    for (int16_t i = 0; i <= page_last - page_first; i++)
+    {
+        page = (int16_t)((page_shift > 0) ? page_last - i : page_first + i);
+        dst = u8g2->tile_buf_ptr + (size_t)page * u8g2->pixel_buf_width +
+            dst_x;
+        src = u8g2->tile_buf_ptr +
+            (size_t)(page - page_shift) * u8g2->pixel_buf_width + src_x;
+        mask = page_mask(page, dst_y, (int16_t)(dst_y + h));
+
+        if (mask == 0xFF)
+        {
+            memmove(dst, src, (size_t)w);
+        }
+        else if (dst_x <= src_x)
+        {
+            for (int16_t x = 0; x < w; x++)
+            {
+                dst[x] = (uint8_t)((dst[x] & ~mask) | (src[x] & mask));
+            }
+        }
+        else
+        {
+            for (int16_t x = (int16_t)(w - 1); x >= 0; x--)
+            {
+                dst[x] = (uint8_t)((dst[x] & ~mask) | (src[x] & mask));
+            }
+        }
+    }
+}
+
+static void
+copy_shifted(u8g2_t *u8g2, int16_t src_x, int16_t src_y, int16_t w,
+    int16_t h, int16_t dst_x, int16_t dst_y)
+{
+    int16_t page_first = (int16_t)(dst_y >> 3);
+    int16_t page_last = (int16_t)((dst_y + h - 1) >> 3);
+    int16_t dy = (int16_t)(dst_y - src_y);
+    int16_t col;
+    int16_t page;
+    uint8_t *dst;
+    uint8_t mask;
+
+    // Column order keeps source columns intact when moving horizontally,
+    // page order keeps source pages of current column intact
+    for (int16_t i = 0; i < w; i++)
+    {
+        col = (int16_t)((dst_x > src_x) ? w - 1 - i : i);
+
+        for (int16_t j = 0; j <= page_last - page_first; j++)
+        {
+            page = (int16_t)((dy > 0) ? page_last - j : page_first + j);
+            dst = u8g2->tile_buf_ptr + (size_t)page * u8g2->pixel_buf_width +
+                dst_x + col;
+            mask = page_mask(page, dst_y, (int16_t)(dst_y + h));
+
+            *dst = (uint8_t)((*dst & ~mask) |
+                (column_byte(u8g2, (int16_t)(src_x + col),
+                (int16_t)(page * 8 - dy)) & mask));
+        }
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,274 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_scale.c
+* @version 1.0.0
+*
+* @brief Bitmaps and glyphs drawn at integer scale.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <string.h>
+
+#include <lib_u8g2_scale.h>
+#include <lib_u8g2_font.h>
+#include <lib_u8g2_span.h>
+#include <lib_u8g2_dirty.h>
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static uint8_t
+is_supported(u8g2_t *u8g2, uint8_t scale);
+
+static uint32_t
+xbm_column(const uint8_t *xbm, uint8_t w, uint8_t h, uint8_t col);
+
+static void
+glyph_run(void *p_ctx, uint8_t x, uint8_t y, uint8_t len);
+
+static void
+draw_column(u8g2_t *u8g2, int16_t x, int16_t y, uint8_t scale,
+    uint32_t bits, uint8_t h);
+
+static void
+write_bits(u8g2_t *u8g2, int16_t x, int16_t y, uint8_t scale,
+    uint32_t pattern, uint8_t cnt);
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+
+// Nibble spread to 4 * scale bits, each bit repeated scale times
+static const uint16_t g_spread[LIB_U8G2_SCALE_MAX - 1][16] = {
+    { 0x0000, 0x0003, 0x000C, 0x000F, 0x0030, 0x0033, 0x003C, 0x003F,
+      0x00C0, 0x00C3, 0x00CC, 0x00CF, 0x00F0, 0x00F3, 0x00FC, 0x00FF },
+    { 0x0000, 0x0007, 0x0038, 0x003F, 0x01C0, 0x01C7, 0x01F8, 0x01FF,
+      0x0E00, 0x0E07, 0x0E38, 0x0E3F, 0x0FC0, 0x0FC7, 0x0FF8, 0x0FFF },
+    { 0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF,
+      0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF }
+};
+
+// Glyph bitmap columns, bit n is row n
+static uint32_t g_columns[LIB_U8G2_SCALE_MAX_SIZE];
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+uint8_t
+lib_u8g2_DrawScaledXBM(u8g2_t *u8g2, int16_t x, int16_t y, uint8_t w,
+    uint8_t h, uint8_t scale, const uint8_t *xbm)
+{
+    if (!is_supported(u8g2, scale))
+    {
+        return 0;
+    }
+
+    h = (h > LIB_U8G2_SCALE_MAX_SIZE) ? LIB_U8G2_SCALE_MAX_SIZE : h;
+    for (uint8_t col = 0; col < w; col++)
+    {
+        draw_column(u8g2, (int16_t)(x + col * scale), y, scale,
+            xbm_column(xbm, w, h, col), h);
+    }
+
+    lib_u8g2_MarkDirty(u8g2, x, y, (int16_t)(x + w * scale),
+        (int16_t)(y + h * scale));
+
+    return 1;
+}
+
+int16_t
+lib_u8g2_DrawScaledGlyph(u8g2_t *u8g2, int16_t x, int16_t y, uint8_t scale,
+    uint16_t encoding)
+{
+    lib_u8g2_glyph_info_t info;
+    const uint8_t *glyph_data;
+    uint8_t w;
+    uint8_t h;
+
+    glyph_data = lib_u8g2_GetGlyphData(u8g2, encoding);
+    if ((glyph_data == NULL) || !is_supported(u8g2, scale))
+    {
+        return 0;
+    }
+
+    memset(g_columns, 0, sizeof(g_columns));
+    lib_u8g2_DecodeGlyph(u8g2, glyph_data, &info, glyph_run, NULL);
+
+    w = (info.width > LIB_U8G2_SCALE_MAX_SIZE) ?
+        LIB_U8G2_SCALE_MAX_SIZE : info.width;
+    h = (info.height > LIB_U8G2_SCALE_MAX_SIZE) ?
+        LIB_U8G2_SCALE_MAX_SIZE : info.height;
+
+    // Reference position and glyph offsets are magnified too
+    x = (int16_t)(x + info.x * scale);
+    y = (int16_t)(y + ((u8g2_int_t)u8g2->font_calc_vref(u8g2) + info.y) *
+        scale);
+    for (uint8_t col = 0; col < w; col++)
+    {
+        draw_column(u8g2, (int16_t)(x + col * scale), y, scale,
+            g_columns[col], h);
+    }
+
+    if (w > 0)
+    {
+        lib_u8g2_MarkDirty(u8g2, x, y, (int16_t)(x + w * scale),
+            (int16_t)(y + h * scale));
+    }
+
+    return (int16_t)(info.delta * scale);
+}
+
+int16_t
+lib_u8g2_DrawScaledUTF8(u8g2_t *u8g2, int16_t x, int16_t y, uint8_t scale,
+    const char *s)
+{
+    int16_t sum = 0;
+    int16_t delta;
+    uint16_t encoding;
+
+    while ((encoding = lib_u8g2_NextUTF8(&s)) != 0)
+    {
+        delta = lib_u8g2_DrawScaledGlyph(u8g2, x, y, scale, encoding);
+        x = (int16_t)(x + delta);
+        sum = (int16_t)(sum + delta);
+    }
+
+    return sum;
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static uint8_t
+is_supported(u8g2_t *u8g2, uint8_t scale)
+{
+    return (uint8_t)(lib_u8g2_IsSpanBuffer(u8g2) &&
+        (u8g2->tile_buf_height == u8x8_GetRows(u8g2_GetU8x8(u8g2))) &&
+        (scale >= 1) && (scale <= LIB_U8G2_SCALE_MAX));
+}
+
+static uint32_t
+xbm_column(const uint8_t *xbm, uint8_t w, uint8_t h, uint8_t col)
+{
+    uint8_t stride = (uint8_t)((w + 7) / 8);
+    uint8_t mask = (uint8_t)(1u << (col & 7));
+    const uint8_t *p = xbm + col / 8;
+    uint32_t bits = 0;
+
+    for (uint8_t row = 0; row < h; row++)
+    {
+        if (*p & mask)
+        {
+            bits |= 1ul << row;
+        }
+        p += stride;
+    }
+
+    return bits;
+}
+
+static void
+glyph_run(void *p_ctx, uint8_t x, uint8_t y, uint8_t len)
+{
+    if (y >= LIB_U8G2_SCALE_MAX_SIZE)
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; (i < len) && (x + i < LIB_U8G2_SCALE_MAX_SIZE); i++)
+    {
+        g_columns[x + i] |= 1ul << y;
+    }
+}
+
+static void
+draw_column(u8g2_t *u8g2, int16_t x, int16_t y, uint8_t scale,
+    uint32_t bits, uint8_t h)
+{
+    uint8_t chunk;
+    uint32_t pattern;
+
+    // Source rows in chunks of 8, each spread to 8 * scale rows
+    for (uint8_t row = 0; (row < h) && (bits != 0); row += 8)
+    {
+        chunk = (uint8_t)bits;
+        bits >>= 8;
+        if (chunk == 0)
+        {
+            continue;
+        }
+
+        if (scale == 1)
+        {
+            pattern = chunk;
+        }
+        else
+        {
+            pattern = g_spread[scale - 2][chunk & 0x0F] |
+                ((uint32_t)g_spread[scale - 2][chunk >> 4] << (4 * scale));
+        }
+        write_bits(u8g2, x, (int16_t)(y + row * scale), scale, pattern,
+            (uint8_t)(8 * scale));
+    }
+}
+
+static void
+write_bits(u8g2_t *u8g2, int16_t x, int16_t y, uint8_t scale,
+    uint32_t pattern, uint8_t cnt)
+{
+    int16_t width = (int16_t)u8g2->pixel_buf_width;
+    int16_t pages = (int16_t)u8g2->tile_buf_height;
+    uint8_t color = u8g2->draw_color;
+    int16_t x0 = (x < 0) ? 0 : x;
+    int16_t x1 = (x + scale > width) ? width : (int16_t)(x + scale);
+    int16_t page;
+    uint64_t bits;
+    uint8_t byte;
+    uint8_t *p;
+
+    if ((x0 >= x1) || (y + cnt <= 0))
+    {
+        return;
+    }
+
+    if (y < 0)
+    {
+        pattern >>= -y;
+        y = 0;
+    }
+
+    // Pattern aligned to page, written as up to 5 bytes per column
+    bits = (uint64_t)pattern << (y & 7);
+    for (page = (int16_t)(y >> 3); (bits != 0) && (page < pages); page++)
+    {
+        byte = (uint8_t)bits;
+        bits >>= 8;
+        if (byte == 0)
+        {
+            continue;
+        }
+
+        p = u8g2->tile_buf_ptr + page * width;
+        for (int16_t col = x0; col < x1; col++)
+        {
+            if (color == 0)
+            {
+                p[col] = (uint8_t)(p[col] & ~byte);
+            }
+            else if (color == 1)
+            {
+                p[col] = (uint8_t)(p[col] | byte);
+            }
+            else
+            {
+                p[col] = (uint8_t)(p[col] ^ byte);
+            }
+        }
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,503 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_scroll.c
+* @version 1.0.0
+*
+* @brief Hardware assisted scrolling for SSD1306 displays.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <lib_u8g2_scroll.h>
+#include <lib_u8g2_span.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+#define SSD1306_RAM_ROWS            (64)
+#define SSD1306_RAM_PAGES           (8)
+
+#define CMD_SET_START_LINE          (0x40)
+#define CMD_DEACTIVATE_SCROLL       (0x2E)
+#define CMD_CONTENT_SCROLL_RIGHT    (0x2C)
+#define CMD_CONTENT_SCROLL_LEFT     (0x2D)
+#define CMD_SET_COLUMN_HI           (0x10)
+#define CMD_SET_COLUMN_LO           (0x00)
+#define CMD_SET_PAGE                (0xB0)
+
+#define SEND_CHUNK_SIZE             (16)
+
+/*******************************************************************************
+* Private types
+*******************************************************************************/
+
+typedef struct
+{
+    int16_t x0;     // Half-open ranges, empty if x0 >= x1
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+} area_t;
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static uint8_t
+is_supported(u8g2_t *u8g2);
+
+static void
+shift_rows(u8g2_t *u8g2, int16_t rows);
+
+static uint8_t
+buffer_byte(u8g2_t *u8g2, int16_t row, int16_t x);
+
+static void
+send_ram_page(u8g2_t *u8g2, uint8_t ram_page, int16_t x0, int16_t x1);
+
+static void
+send_content_scroll(u8g2_t *u8g2, uint8_t cmd, uint8_t page_first,
+    uint8_t page_last, int16_t x0, int16_t x1);
+
+static void
+pending_add(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+
+static uint8_t g_start_line;
+static area_t g_pending;    // Area exposed by scrolling, not yet sent
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void
+lib_u8g2_ScrollReset(u8g2_t *u8g2)
+{
+    u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+
+    u8x8_cad_StartTransfer(u8x8);
+    u8x8_cad_SendCmd(u8x8, CMD_DEACTIVATE_SCROLL);
+    u8x8_cad_SendCmd(u8x8, CMD_SET_START_LINE);
+    u8x8_cad_EndTransfer(u8x8);
+
+    g_start_line = 0;
+    g_pending.x1 = g_pending.x0;
+
+    u8g2_SendBuffer(u8g2);
+}
+
+uint8_t
+lib_u8g2_ScrollVertical(u8g2_t *u8g2, int16_t rows)
+{
+    u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+    int16_t height;
+    int16_t width;
+
+    if (!is_supported(u8g2))
+    {
+        return 0;
+    }
+    if (rows == 0)
+    {
+        return 1;
+    }
+
+    height = (int16_t)(u8g2->tile_buf_height * 8);
+    width = (int16_t)u8g2->pixel_buf_width;
+
+    shift_rows(u8g2, rows);
+
+    g_start_line = (uint8_t)((g_start_line + rows % SSD1306_RAM_ROWS +
+        SSD1306_RAM_ROWS) % SSD1306_RAM_ROWS);
+
+    u8x8_cad_StartTransfer(u8x8);
+    u8x8_cad_SendCmd(u8x8, (uint8_t)(CMD_SET_START_LINE | g_start_line));
+    u8x8_cad_EndTransfer(u8x8);
+
+    // Pending area moves together with display content
+    if (g_pending.x0 < g_pending.x1)
+    {
+        g_pending.y0 = (int16_t)(g_pending.y0 - rows);
+        g_pending.y1 = (int16_t)(g_pending.y1 - rows);
+        if (g_pending.y0 < 0)
+        {
+            g_pending.y0 = 0;
+        }
+        if (g_pending.y1 > height)
+        {
+            g_pending.y1 = height;
+        }
+        if (g_pending.y0 >= g_pending.y1)
+        {
+            g_pending.x1 = g_pending.x0;
+        }
+    }
+
+    if (rows > 0)
+    {
+        pending_add(0, (int16_t)(height - rows), width, height);
+    }
+    else
+    {
+        pending_add(0, 0, width, (int16_t)-rows);
+    }
+
+    return 1;
+}
+
+uint8_t
+lib_u8g2_ScrollHorizontal(u8g2_t *u8g2, int16_t cols, uint8_t page_first,
+    uint8_t page_last)
+{
+    return lib_u8g2_ScrollWindow(u8g2, cols, 0,
+        (int16_t)u8g2->pixel_buf_width, page_first, page_last);
+}
+
+uint8_t
+lib_u8g2_ScrollWindow(u8g2_t *u8g2, int16_t cols, int16_t x0, int16_t x1,
+    uint8_t page_first, uint8_t page_last)
+{
+    int16_t width;
+    int16_t band_y0 = (int16_t)(page_first * 8);
+    int16_t band_y1 = (int16_t)(page_last * 8 + 8);
+    int16_t steps = (int16_t)abs(cols);
+    uint8_t *row;
+    uint8_t ram_first;
+    uint8_t ram_last;
+    uint8_t cmd;
+
+    if (!is_supported(u8g2) || (page_first > page_last) ||
+        (page_last >= u8g2->tile_buf_height) || (x0 < 0) || (x0 >= x1) ||
+        (x1 > (int16_t)u8g2->pixel_buf_width))
+    {
+        return 0;
+    }
+    if (cols == 0)
+    {
+        return 1;
+    }
+
+    width = (int16_t)(x1 - x0);
+    if (steps > width)
+    {
+        steps = width;
+    }
+
+    // Frame buffer
+    for (uint8_t page = page_first; page <= page_last; page++)
+    {
+        row = u8g2->tile_buf_ptr + (size_t)page * u8g2->pixel_buf_width + x0;
+        if (cols > 0)
+        {
+            memmove(row, row + steps, (size_t)(width - steps));
+            memset(row + width - steps, 0, (size_t)steps);
+        }
+        else
+        {
+            memmove(row + steps, row, (size_t)(width - steps));
+            memset(row, 0, (size_t)steps);
+        }
+    }
+
+    // Content scroll works on display RAM pages, only possible if frame
+    // buffer pages are aligned to them
+    if ((steps > (int16_t)LIB_U8G2_SCROLL_MAX_HW_STEPS) ||
+        (steps == width) || ((g_start_line & 7) != 0))
+    {
+        pending_add(x0, band_y0, x1, band_y1);
+        return 1;
+    }
+
+    ram_first = (uint8_t)((page_first + (g_start_line >> 3)) %
+        SSD1306_RAM_PAGES);
+    ram_last = (uint8_t)((page_last + (g_start_line >> 3)) %
+        SSD1306_RAM_PAGES);
+    cmd = (cols > 0) ? CMD_CONTENT_SCROLL_LEFT : CMD_CONTENT_SCROLL_RIGHT;
+
+    for (int16_t i = 0; i < steps; i++)
+    {
+        if (i > 0)
+        {
+            u8x8_gpio_Delay(u8g2_GetU8x8(u8g2), U8X8_MSG_DELAY_MILLI,
+                LIB_U8G2_SCROLL_STEP_DELAY_MS);
+        }
+
+        if (ram_first <= ram_last)
+        {
+            send_content_scroll(u8g2, cmd, ram_first, ram_last, x0, x1);
+        }
+        else
+        {
+            // Band wraps around display RAM end
+            send_content_scroll(u8g2, cmd, ram_first, SSD1306_RAM_PAGES - 1,
+                x0, x1);
+            send_content_scroll(u8g2, cmd, 0, ram_last, x0, x1);
+        }
+    }
+
+    // Pending area moves together with window content
+    if ((g_pending.x0 < g_pending.x1) && (g_pending.y0 < band_y1) &&
+        (g_pending.y1 > band_y0) && (g_pending.x0 < x1) &&
+        (g_pending.x1 > x0))
+    {
+        area_t moved = g_pending;
+
+        moved.x0 = (int16_t)(moved.x0 - cols);
+        moved.x1 = (int16_t)(moved.x1 - cols);
+        moved.x0 = (moved.x0 < x0) ? x0 : moved.x0;
+        moved.x1 = (moved.x1 > x1) ? x1 : moved.x1;
+        if ((g_pending.y0 >= band_y0) && (g_pending.y1 <= band_y1) &&
+            (g_pending.x0 >= x0) && (g_pending.x1 <= x1))
+        {
+            // Whole area moved, otherwise keep both positions
+            g_pending.x1 = g_pending.x0;
+        }
+        pending_add(moved.x0, moved.y0, moved.x1, moved.y1);
+    }
+
+    if (cols > 0)
+    {
+        pending_add((int16_t)(x1 - steps), band_y0, x1, band_y1);
+    }
+    else
+    {
+        pending_add(x0, band_y0, (int16_t)(x0 + steps), band_y1);
+    }
+
+    return 1;
+}
+
+void
+lib_u8g2_SendScrolled(u8g2_t *u8g2)
+{
+    if (g_pending.x0 < g_pending.x1)
+    {
+        lib_u8g2_ScrollSendArea(u8g2, g_pending.x0, g_pending.y0,
+            g_pending.x1, g_pending.y1);
+        g_pending.x1 = g_pending.x0;
+    }
+}
+
+void
+lib_u8g2_ScrollSendArea(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1,
+    int16_t y1)
+{
+    int16_t width = (int16_t)u8g2->pixel_buf_width;
+    int16_t height = (int16_t)(u8g2->tile_buf_height * 8);
+    uint8_t page_mask = 0;
+
+    if (x0 < 0)
+    {
+        x0 = 0;
+    }
+    if (y0 < 0)
+    {
+        y0 = 0;
+    }
+    if (x1 > width)
+    {
+        x1 = width;
+    }
+    if (y1 > height)
+    {
+        y1 = height;
+    }
+    if ((x0 >= x1) || (y0 >= y1))
+    {
+        return;
+    }
+
+    // Display RAM pages holding the rows
+    for (int16_t y = y0; y < y1; y++)
+    {
+        page_mask = (uint8_t)(page_mask |
+            (1u << (((y + g_start_line) % SSD1306_RAM_ROWS) >> 3)));
+    }
+
+    for (uint8_t page = 0; page < SSD1306_RAM_PAGES; page++)
+    {
+        if (page_mask & (1u << page))
+        {
+            send_ram_page(u8g2, page, x0, x1);
+        }
+    }
+}
+
+uint8_t
+lib_u8g2_GetStartLine(void)
+{
+    return g_start_line;
+}
+
+void
+lib_u8g2_SetStartLine(uint8_t line)
+{
+    g_start_line = (uint8_t)(line % SSD1306_RAM_ROWS);
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static uint8_t
+is_supported(u8g2_t *u8g2)
+{
+    return (uint8_t)(lib_u8g2_IsSpanBuffer(u8g2) &&
+        (u8g2->tile_buf_height == u8x8_GetRows(u8g2_GetU8x8(u8g2))) &&
+        (u8g2->tile_buf_height <= SSD1306_RAM_PAGES));
+}
+
+static void
+shift_rows(u8g2_t *u8g2, int16_t rows)
+{
+    uint8_t *ptr;
+    int16_t page_cnt = (int16_t)u8g2->tile_buf_height;
+    int16_t width = (int16_t)u8g2->pixel_buf_width;
+
+    if (abs(rows) >= page_cnt * 8)
+    {
+        memset(u8g2->tile_buf_ptr, 0, (size_t)(page_cnt * width));
+        return;
+    }
+
+    // Destination page p gets rows starting at 8 * p + rows, process pages
+    // in order not overwriting source pages
+    for (int16_t i = 0; i < page_cnt; i++)
+    {
+        int16_t page = (rows > 0) ? i : (int16_t)(page_cnt - 1 - i);
+
+        ptr = u8g2->tile_buf_ptr + (size_t)page * u8g2->pixel_buf_width;
+        for (int16_t x = 0; x < width; x++)
+        {
+            ptr[x] = buffer_byte(u8g2, (int16_t)(page * 8 + rows), x);
+        }
+    }
+}
+
+static uint8_t
+buffer_byte(u8g2_t *u8g2, int16_t row, int16_t x)
+{
+    // Eight rows starting at given row, rows outside of buffer are empty
+    int16_t page_cnt = (int16_t)u8g2->tile_buf_height;
+    int16_t page = (int16_t)((row + 8 * SSD1306_RAM_ROWS) / 8 - SSD1306_RAM_ROWS);
+    uint8_t bit = (uint8_t)((row + 8 * SSD1306_RAM_ROWS) % 8);
+    uint16_t value = 0;
+
+    if ((page >= 0) && (page < page_cnt))
+    {
+        value = u8g2->tile_buf_ptr[(size_t)page * u8g2->pixel_buf_width + x];
+    }
+    if ((page + 1 >= 0) && (page + 1 < page_cnt))
+    {
+        value = (uint16_t)(value |
+            (u8g2->tile_buf_ptr[(size_t)(page + 1) * u8g2->pixel_buf_width + x]
+            << 8));
+    }
+
+    return (uint8_t)(value >> bit);
+}
+
+static void
+send_ram_page(u8g2_t *u8g2, uint8_t ram_page, int16_t x0, int16_t x1)
+{
+    u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+    uint8_t chunk[SEND_CHUNK_SIZE];
+    uint8_t cnt;
+    uint8_t col = (uint8_t)(x0 + u8x8->x_offset);
+    int16_t row;
+
+    // Frame buffer row shown by first row of display RAM page
+    row = (int16_t)((ram_page * 8 - g_start_line + SSD1306_RAM_ROWS) %
+        SSD1306_RAM_ROWS);
+
+    u8x8_cad_StartTransfer(u8x8);
+    u8x8_cad_SendCmd(u8x8, (uint8_t)(CMD_SET_COLUMN_HI | (col >> 4)));
+    u8x8_cad_SendArg(u8x8, (uint8_t)(CMD_SET_COLUMN_LO | (col & 0x0F)));
+    u8x8_cad_SendArg(u8x8, (uint8_t)(CMD_SET_PAGE | ram_page));
+
+    while (x0 < x1)
+    {
+        cnt = (uint8_t)((x1 - x0 > SEND_CHUNK_SIZE) ?
+            SEND_CHUNK_SIZE : x1 - x0);
+        for (uint8_t i = 0; i < cnt; i++)
+        {
+            if (row + 8 <= SSD1306_RAM_ROWS)
+            {
+                chunk[i] = buffer_byte(u8g2, row, (int16_t)(x0 + i));
+            }
+            else
+            {
+                // Page wraps around display RAM end
+                chunk[i] = (uint8_t)(buffer_byte(u8g2, row, (int16_t)(x0 + i)) |
+                    (buffer_byte(u8g2, 0, (int16_t)(x0 + i)) <<
+                    (SSD1306_RAM_ROWS - row)));
+            }
+        }
+        u8x8_cad_SendData(u8x8, cnt, chunk);
+        x0 = (int16_t)(x0 + cnt);
+    }
+
+    u8x8_cad_EndTransfer(u8x8);
+}
+
+static void
+send_content_scroll(u8g2_t *u8g2, uint8_t cmd, uint8_t page_first,
+    uint8_t page_last, int16_t x0, int16_t x1)
+{
+    u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+
+    u8x8_cad_StartTransfer(u8x8);
+    u8x8_cad_SendCmd(u8x8, cmd);
+    u8x8_cad_SendArg(u8x8, 0x00);
+    u8x8_cad_SendArg(u8x8, page_first);
+    u8x8_cad_SendArg(u8x8, 0x01);
+    u8x8_cad_SendArg(u8x8, page_last);
+    u8x8_cad_SendArg(u8x8, 0x00);
+    u8x8_cad_SendArg(u8x8, (uint8_t)(u8x8->x_offset + x0));
+    u8x8_cad_SendArg(u8x8, (uint8_t)(u8x8->x_offset + x1 - 1));
+    u8x8_cad_EndTransfer(u8x8);
+}
+
+static void
+pending_add(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    if ((x0 >= x1) || (y0 >= y1))
+    {
+        return;
+    }
+
+    if (g_pending.x0 >= g_pending.x1)
+    {
+        g_pending.x0 = x0;
+        g_pending.y0 = y0;
+        g_pending.x1 = x1;
+        g_pending.y1 = y1;
+        return;
+    }
+
+    if (x0 < g_pending.x0)
+    {
+        g_pending.x0 = x0;
+    }
+    if (y0 < g_pending.y0)
+    {
+        g_pending.y0 = y0;
+    }
+    if (x1 > g_pending.x1)
+    {
+        g_pending.x1 = x1;
+    }
+    if (y1 > g_pending.y1)
+    {
+        g_pending.y1 = y1;
+    }
+}
+
+/* [] END OF FILE */
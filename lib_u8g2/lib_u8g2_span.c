@@ -0,0 +1,550 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_span.c
+* @version 1.0.0
+*
+* @brief Word-wide span fill kernels for vertical byte (SSD1306) buffers.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <stddef.h>
+#include <time.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+#include <lib_u8g2_span.h>
+#include <lib_u8g2_dirty.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+// Word type used by horizontal span kernel, may alias buffer bytes
+#if defined(__LP64__) || defined(_WIN64)
+typedef uint64_t span_word_base_t;
+#define SPAN_WORD_ONES          (0x0101010101010101ull)
+#else
+typedef uint32_t span_word_base_t;
+#define SPAN_WORD_ONES          (0x01010101ul)
+#endif
+
+#ifdef __GNUC__
+typedef span_word_base_t __attribute__((__may_alias__)) span_word_t;
+#else
+typedef span_word_base_t span_word_t;
+#endif
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static void
+span_apply(uint8_t *ptr, size_t len, uint8_t or_mask, uint8_t xor_mask);
+
+static void
+column_apply(uint8_t *ptr, size_t stride, uint8_t bit, size_t len,
+    uint8_t color);
+
+static void
+bench_workload(u8g2_t *u8g2, uint8_t is_lib);
+
+static uint32_t
+elapsed_us(const struct timespec *p_start);
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void
+lib_u8g2_SetSpanBackend(u8g2_t *u8g2)
+{
+    if (u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb)
+    {
+        u8g2->ll_hvline = lib_u8g2_ll_hvline;
+    }
+}
+
+void
+lib_u8g2_ll_hvline(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    u8g2_uint_t len, uint8_t dir)
+{
+    uint8_t *ptr = u8g2->tile_buf_ptr +
+        (size_t)(y >> 3) * u8g2->pixel_buf_width + x;
+    uint8_t mask;
+
+    if (dir == 0)
+    {
+        mask = (uint8_t)(1u << (y & 7));
+        span_apply(ptr, len,
+            (u8g2->draw_color <= 1) ? mask : 0,
+            (u8g2->draw_color != 1) ? mask : 0);
+    }
+    else
+    {
+        column_apply(ptr, u8g2->pixel_buf_width, (uint8_t)(y & 7), len,
+            u8g2->draw_color);
+    }
+}
+
+uint8_t
+lib_u8g2_IsSpanBuffer(u8g2_t *u8g2)
+{
+    u8g2_draw_ll_hvline_cb ll_hvline = u8g2->ll_hvline;
+
+    // Look through dirty tracking wrapper
+    if (ll_hvline == lib_u8g2_dirty_ll_hvline)
+    {
+        ll_hvline = lib_u8g2_GetTrackedHvline();
+    }
+
+    return (uint8_t)((u8g2->cb == U8G2_R0) &&
+        ((ll_hvline == lib_u8g2_ll_hvline) ||
+        (ll_hvline == u8g2_ll_hvline_vertical_top_lsb)));
+}
+
+void
+lib_u8g2_SpanBegin(lib_u8g2_span_t *p_span, u8g2_t *u8g2)
+{
+    p_span->u8g2 = u8g2;
+    p_span->color = u8g2->draw_color;
+    p_span->is_direct = lib_u8g2_IsSpanBuffer(u8g2);
+
+    // Display area, u8g2 clips the rest in indirect mode
+    p_span->x0 = 0;
+    p_span->y0 = 0;
+    p_span->x1 = (int16_t)u8g2_GetDisplayWidth(u8g2);
+    p_span->y1 = (int16_t)u8g2_GetDisplayHeight(u8g2);
+
+    if (!p_span->is_direct)
+    {
+        return;
+    }
+
+    // Current page (user window)
+    if (p_span->x0 < (int16_t)u8g2->user_x0)
+    {
+        p_span->x0 = (int16_t)u8g2->user_x0;
+    }
+    if (p_span->x1 > (int16_t)u8g2->user_x1)
+    {
+        p_span->x1 = (int16_t)u8g2->user_x1;
+    }
+    if (p_span->y0 < (int16_t)u8g2->user_y0)
+    {
+        p_span->y0 = (int16_t)u8g2->user_y0;
+    }
+    if (p_span->y1 > (int16_t)u8g2->user_y1)
+    {
+        p_span->y1 = (int16_t)u8g2->user_y1;
+    }
+
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+    if (u8g2->is_page_clip_window_intersection == 0)
+    {
+        p_span->x1 = p_span->x0;
+        return;
+    }
+    if (p_span->x0 < (int16_t)u8g2->clip_x0)
+    {
+        p_span->x0 = (int16_t)u8g2->clip_x0;
+    }
+    if (p_span->x1 > (int16_t)u8g2->clip_x1)
+    {
+        p_span->x1 = (int16_t)u8g2->clip_x1;
+    }
+    if (p_span->y0 < (int16_t)u8g2->clip_y0)
+    {
+        p_span->y0 = (int16_t)u8g2->clip_y0;
+    }
+    if (p_span->y1 > (int16_t)u8g2->clip_y1)
+    {
+        p_span->y1 = (int16_t)u8g2->clip_y1;
+    }
+#endif
+}
+
+void
+lib_u8g2_SpanFill(const lib_u8g2_span_t *p_span, int16_t x0, int16_t y0,
+    int16_t x1, int16_t y1)
+{
+    u8g2_t *u8g2 = p_span->u8g2;
+    uint8_t *ptr;
+    int16_t page;
+    int16_t page_last;
+    uint8_t mask;
+
+    if (x0 < p_span->x0)
+    {
+        x0 = p_span->x0;
+    }
+    if (y0 < p_span->y0)
+    {
+        y0 = p_span->y0;
+    }
+    if (x1 > p_span->x1)
+    {
+        x1 = p_span->x1;
+    }
+    if (y1 > p_span->y1)
+    {
+        y1 = p_span->y1;
+    }
+    if ((x0 >= x1) || (y0 >= y1))
+    {
+        return;
+    }
+
+    if (!p_span->is_direct)
+    {
+        // Draw along the longer side to minimize number of calls
+        if (x1 - x0 >= y1 - y0)
+        {
+            for (int16_t y = y0; y < y1; y++)
+            {
+                u8g2_DrawHVLine(u8g2, (u8g2_uint_t)x0, (u8g2_uint_t)y,
+                    (u8g2_uint_t)(x1 - x0), 0);
+            }
+        }
+        else
+        {
+            for (int16_t x = x0; x < x1; x++)
+            {
+                u8g2_DrawHVLine(u8g2, (u8g2_uint_t)x, (u8g2_uint_t)y0,
+                    (u8g2_uint_t)(y1 - y0), 1);
+            }
+        }
+        return;
+    }
+
+    lib_u8g2_MarkDirty(u8g2, x0, y0, x1, y1);
+
+    // Buffer coordinates
+    y0 = (int16_t)(y0 - (int16_t)u8g2->pixel_curr_row);
+    y1 = (int16_t)(y1 - (int16_t)u8g2->pixel_curr_row);
+
+    if (x1 - x0 == 1)
+    {
+        // Single column, whole bytes across pages
+        column_apply(u8g2->tile_buf_ptr +
+            (size_t)(y0 >> 3) * u8g2->pixel_buf_width + x0,
+            u8g2->pixel_buf_width, (uint8_t)(y0 & 7), (size_t)(y1 - y0),
+            p_span->color);
+        return;
+    }
+
+    // One page mask applied to all bytes of each page row
+    page = (int16_t)(y0 >> 3);
+    page_last = (int16_t)((y1 - 1) >> 3);
+    ptr = u8g2->tile_buf_ptr + (size_t)page * u8g2->pixel_buf_width + x0;
+
+    for (; page <= page_last; page++)
+    {
+        mask = 0xFF;
+        if (page == (y0 >> 3))
+        {
+            mask = (uint8_t)(mask << (y0 & 7));
+        }
+        if (page == page_last)
+        {
+            mask = (uint8_t)(mask & (0xFFu >> (7 - ((y1 - 1) & 7))));
+        }
+
+        span_apply(ptr, (size_t)(x1 - x0),
+            (p_span->color <= 1) ? mask : 0,
+            (p_span->color != 1) ? mask : 0);
+
+        ptr += u8g2->pixel_buf_width;
+    }
+}
+
+void
+lib_u8g2_SpanPixel(const lib_u8g2_span_t *p_span, int16_t x, int16_t y)
+{
+    u8g2_t *u8g2 = p_span->u8g2;
+    uint8_t *ptr;
+    uint8_t mask;
+
+    if ((x < p_span->x0) || (x >= p_span->x1) ||
+        (y < p_span->y0) || (y >= p_span->y1))
+    {
+        return;
+    }
+
+    if (!p_span->is_direct)
+    {
+        u8g2_DrawPixel(u8g2, (u8g2_uint_t)x, (u8g2_uint_t)y);
+        return;
+    }
+
+    lib_u8g2_MarkDirty(u8g2, x, y, (int16_t)(x + 1), (int16_t)(y + 1));
+
+    y = (int16_t)(y - (int16_t)u8g2->pixel_curr_row);
+    ptr = u8g2->tile_buf_ptr + (size_t)(y >> 3) * u8g2->pixel_buf_width + x;
+    mask = (uint8_t)(1u << (y & 7));
+
+    if (p_span->color <= 1)
+    {
+        *ptr |= mask;
+    }
+    if (p_span->color != 1)
+    {
+        *ptr ^= mask;
+    }
+}
+
+void
+lib_u8g2_FillArea(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1,
+    int16_t y1)
+{
+    lib_u8g2_span_t span;
+
+    lib_u8g2_SpanBegin(&span, u8g2);
+    lib_u8g2_SpanFill(&span, x0, y0, x1, y1);
+}
+
+void
+lib_u8g2_DrawHSpan(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    u8g2_uint_t len)
+{
+    lib_u8g2_FillArea(u8g2, (int16_t)x, (int16_t)y, (int16_t)(x + len),
+        (int16_t)(y + 1));
+}
+
+void
+lib_u8g2_DrawVSpan(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    u8g2_uint_t len)
+{
+    lib_u8g2_FillArea(u8g2, (int16_t)x, (int16_t)y, (int16_t)(x + 1),
+        (int16_t)(y + len));
+}
+
+void
+lib_u8g2_DrawBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    u8g2_uint_t w, u8g2_uint_t h)
+{
+    lib_u8g2_FillArea(u8g2, (int16_t)x, (int16_t)y, (int16_t)(x + w),
+        (int16_t)(y + h));
+}
+
+void
+lib_u8g2_DrawFrame(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
+    u8g2_uint_t w, u8g2_uint_t h)
+{
+    int16_t x0 = (int16_t)x;
+    int16_t y0 = (int16_t)y;
+    int16_t x1 = (int16_t)(x + w);
+    int16_t y1 = (int16_t)(y + h);
+
+    if ((w == 0) || (h == 0))
+    {
+        return;
+    }
+
+    // Frame one pixel wide or high is a single span, each pixel is drawn
+    // once also in XOR mode (u8g2 toggles both coinciding sides instead)
+    if ((w == 1) || (h == 1))
+    {
+        lib_u8g2_FillArea(u8g2, x0, y0, x1, y1);
+        return;
+    }
+
+    // Corners are drawn once so XOR mode gives the same result as u8g2
+    lib_u8g2_FillArea(u8g2, x0, y0, x1, (int16_t)(y0 + 1));
+    lib_u8g2_FillArea(u8g2, x0, (int16_t)(y1 - 1), x1, y1);
+    if (h > 2)
+    {
+        lib_u8g2_FillArea(u8g2, x0, (int16_t)(y0 + 1), (int16_t)(x0 + 1),
+            (int16_t)(y1 - 1));
+        lib_u8g2_FillArea(u8g2, (int16_t)(x1 - 1), (int16_t)(y0 + 1), x1,
+            (int16_t)(y1 - 1));
+    }
+}
+
+uint8_t
+lib_u8g2_SpanBenchmark(u8g2_t *u8g2, uint32_t iterations,
+    lib_u8g2_bench_t *p_result)
+{
+    u8g2_draw_ll_hvline_cb ll_hvline = u8g2->ll_hvline;
+    struct timespec ts_start;
+
+    p_result->u8g2_us = 0;
+    p_result->lib_us = 0;
+    if (!lib_u8g2_IsSpanBuffer(u8g2))
+    {
+        return 0;
+    }
+
+    // Callbacks are set directly and tracking is paused, so neither run
+    // records dirty areas, whole buffer is marked dirty afterwards
+    lib_u8g2_PauseDirty(1);
+    u8g2->ll_hvline = u8g2_ll_hvline_vertical_top_lsb;
+    clock_gettime(CLOCK_MONOTONIC, &ts_start);
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        bench_workload(u8g2, 0);
+    }
+    p_result->u8g2_us = elapsed_us(&ts_start);
+
+    u8g2->ll_hvline = lib_u8g2_ll_hvline;
+    clock_gettime(CLOCK_MONOTONIC, &ts_start);
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        bench_workload(u8g2, 1);
+    }
+    p_result->lib_us = elapsed_us(&ts_start);
+
+    u8g2->ll_hvline = ll_hvline;
+    lib_u8g2_PauseDirty(0);
+    u8g2_SetDrawColor(u8g2, 1);
+    u8g2_ClearBuffer(u8g2);
+    lib_u8g2_MarkDirty(u8g2, 0, 0, (int16_t)u8g2_GetDisplayWidth(u8g2),
+        (int16_t)u8g2_GetDisplayHeight(u8g2));
+
+    return 1;
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static void
+bench_workload(u8g2_t *u8g2, uint8_t is_lib)
+{
+    // Screen similar to example display_screen(): frame, boxes, lines,
+    // circle, inverted area and text of current font
+    u8g2_ClearBuffer(u8g2);
+    u8g2_SetDrawColor(u8g2, 1);
+    if (is_lib)
+    {
+        lib_u8g2_DrawFrame(u8g2, 0, 0, 128, 64);
+        lib_u8g2_DrawBox(u8g2, 4, 4, 40, 20);
+        lib_u8g2_DrawBox(u8g2, 50, 10, 70, 30);
+    }
+    else
+    {
+        u8g2_DrawFrame(u8g2, 0, 0, 128, 64);
+        u8g2_DrawBox(u8g2, 4, 4, 40, 20);
+        u8g2_DrawBox(u8g2, 50, 10, 70, 30);
+    }
+
+    for (u8g2_uint_t i = 0; i < 6; i++)
+    {
+        u8g2_DrawHLine(u8g2, 2, (u8g2_uint_t)(26 + i * 6), 100);
+        u8g2_DrawVLine(u8g2, (u8g2_uint_t)(8 + i * 16), 2, 60);
+    }
+    u8g2_DrawDisc(u8g2, 100, 44, 15, U8G2_DRAW_ALL);
+
+    u8g2_SetDrawColor(u8g2, 2);
+    if (is_lib)
+    {
+        lib_u8g2_DrawBox(u8g2, 10, 30, 100, 25);
+    }
+    else
+    {
+        u8g2_DrawBox(u8g2, 10, 30, 100, 25);
+    }
+
+    if (u8g2->font != NULL)
+    {
+        u8g2_SetDrawColor(u8g2, 1);
+        u8g2_DrawStr(u8g2, 2, 62, "Benchmark 0123456789");
+    }
+}
+
+static uint32_t
+elapsed_us(const struct timespec *p_start)
+{
+    struct timespec ts_end;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts_end);
+
+    return (uint32_t)((int64_t)(ts_end.tv_sec - p_start->tv_sec) * 1000000 +
+        (ts_end.tv_nsec - p_start->tv_nsec) / 1000);
+}
+
+static void
+span_apply(uint8_t *ptr, size_t len, uint8_t or_mask, uint8_t xor_mask)
+{
+    span_word_t or_word;
+    span_word_t xor_word;
+    span_word_t *p_word;
+
+    // Leading bytes up to word alignment
+    while ((len > 0) && (((uintptr_t)ptr & (sizeof(span_word_t) - 1)) != 0))
+    {
+        *ptr = (uint8_t)((*ptr | or_mask) ^ xor_mask);
+        ptr++;
+        len--;
+    }
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    if (len >= 16)
+    {
+        uint8x16_t or_vec = vdupq_n_u8(or_mask);
+        uint8x16_t xor_vec = vdupq_n_u8(xor_mask);
+
+        do
+        {
+            vst1q_u8(ptr, veorq_u8(vorrq_u8(vld1q_u8(ptr), or_vec), xor_vec));
+            ptr += 16;
+            len -= 16;
+        } while (len >= 16);
+    }
+#endif
+
+    or_word = (span_word_t)(or_mask * SPAN_WORD_ONES);
+    xor_word = (span_word_t)(xor_mask * SPAN_WORD_ONES);
+    p_word = (span_word_t *)(void *)ptr;
+
+    while (len >= sizeof(span_word_t))
+    {
+        *p_word = (*p_word | or_word) ^ xor_word;
+        p_word++;
+        len -= sizeof(span_word_t);
+    }
+
+    // Trailing bytes
+    ptr = (uint8_t *)p_word;
+    while (len > 0)
+    {
+        *ptr = (uint8_t)((*ptr | or_mask) ^ xor_mask);
+        ptr++;
+        len--;
+    }
+}
+
+static void
+column_apply(uint8_t *ptr, size_t stride, uint8_t bit, size_t len,
+    uint8_t color)
+{
+    uint8_t mask;
+    uint8_t or_mask;
+    uint8_t xor_mask;
+
+    while (len > 0)
+    {
+        // Mask of rows from bit to end of page or end of span
+        mask = (uint8_t)(0xFFu << bit);
+        if (len < (size_t)(8 - bit))
+        {
+            mask = (uint8_t)(mask & (0xFFu >> (8 - bit - len)));
+            len = 0;
+        }
+        else
+        {
+            len -= (size_t)(8 - bit);
+        }
+
+        or_mask = (color <= 1) ? mask : 0;
+        xor_mask = (color != 1) ? mask : 0;
+        *ptr = (uint8_t)((*ptr | or_mask) ^ xor_mask);
+
+        ptr += stride;
+        bit = 0;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,336 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_sprite.c
+* @version 1.0.0
+*
+* @brief Sprites blitted by whole frame buffer bytes.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <string.h>
+
+#include <lib_u8g2_sprite.h>
+#include <lib_u8g2_span.h>
+#include <lib_u8g2_dirty.h>
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static size_t
+phase_offset(const lib_u8g2_sprite_t *p_sprite, uint8_t frame,
+    uint8_t phase);
+
+static uint8_t *
+save_area(const lib_u8g2_sprite_t *p_sprite);
+
+static void
+shift_xbm(uint8_t *p_dst, const uint8_t *xbm, uint8_t w, uint8_t h,
+    uint8_t frame, uint8_t phase);
+
+static void
+blit(u8g2_t *u8g2, lib_u8g2_sprite_t *p_sprite);
+
+static void
+erase(u8g2_t *u8g2, lib_u8g2_sprite_t *p_sprite);
+
+static uint8_t
+clip(u8g2_t *u8g2, const lib_u8g2_sprite_t *p_sprite, int16_t *p_col0,
+    int16_t *p_col1, int16_t *p_page0, int16_t *p_page1, uint8_t *p_phase);
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void
+lib_u8g2_SpriteInit(lib_u8g2_sprite_t *p_sprite, uint8_t *p_buf, uint8_t w,
+    uint8_t h, uint8_t frame_cnt, const uint8_t *bitmap, const uint8_t *mask,
+    lib_u8g2_sprite_mode_t mode)
+{
+    size_t offset;
+    size_t len;
+
+    memset(p_sprite, 0, sizeof(lib_u8g2_sprite_t));
+    p_sprite->p_buf = p_buf;
+    p_sprite->w = w;
+    p_sprite->h = h;
+    p_sprite->frame_cnt = frame_cnt;
+    p_sprite->has_mask = (uint8_t)((mask != NULL) &&
+        (mode == LIB_U8G2_SPRITE_MASKED));
+    p_sprite->mode = mode;
+
+    for (uint8_t frame = 0; frame < frame_cnt; frame++)
+    {
+        for (uint8_t phase = 0; phase < 8; phase++)
+        {
+            offset = phase_offset(p_sprite, frame, phase);
+            len = (size_t)w * ((h + phase + 7) / 8);
+            shift_xbm(p_buf + offset, bitmap, w, h, frame, phase);
+            if (p_sprite->has_mask)
+            {
+                shift_xbm(p_buf + offset + len, mask, w, h, frame, phase);
+            }
+        }
+    }
+}
+
+uint8_t
+lib_u8g2_SpriteMove(u8g2_t *u8g2, lib_u8g2_sprite_t *p_sprite, int16_t x,
+    int16_t y)
+{
+    if (!lib_u8g2_IsSpanBuffer(u8g2) ||
+        (u8g2->tile_buf_height != u8x8_GetRows(u8g2_GetU8x8(u8g2))))
+    {
+        return 0;
+    }
+
+    if (p_sprite->is_shown)
+    {
+        if ((p_sprite->x == x) && (p_sprite->y == y))
+        {
+            return 1;
+        }
+        erase(u8g2, p_sprite);
+    }
+
+    p_sprite->x = x;
+    p_sprite->y = y;
+    blit(u8g2, p_sprite);
+
+    return 1;
+}
+
+void
+lib_u8g2_SpriteSetFrame(u8g2_t *u8g2, lib_u8g2_sprite_t *p_sprite,
+    uint8_t frame)
+{
+    if ((frame >= p_sprite->frame_cnt) || (frame == p_sprite->frame))
+    {
+        return;
+    }
+
+    if (p_sprite->is_shown)
+    {
+        erase(u8g2, p_sprite);
+        p_sprite->frame = frame;
+        blit(u8g2, p_sprite);
+    }
+    else
+    {
+        p_sprite->frame = frame;
+    }
+}
+
+void
+lib_u8g2_SpriteHide(u8g2_t *u8g2, lib_u8g2_sprite_t *p_sprite)
+{
+    if (p_sprite->is_shown)
+    {
+        erase(u8g2, p_sprite);
+    }
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static size_t
+phase_offset(const lib_u8g2_sprite_t *p_sprite, uint8_t frame,
+    uint8_t phase)
+{
+    size_t plane_cnt = p_sprite->has_mask ? 2 : 1;
+    size_t pages = 0;
+
+    // Phase p takes (h + p + 7) / 8 pages, all phases h + 7 pages
+    for (uint8_t i = 0; i < phase; i++)
+    {
+        pages += (size_t)((p_sprite->h + i + 7) / 8);
+    }
+
+    return p_sprite->w * plane_cnt *
+        ((size_t)frame * (p_sprite->h + 7u) + pages);
+}
+
+static uint8_t *
+save_area(const lib_u8g2_sprite_t *p_sprite)
+{
+    return p_sprite->p_buf + phase_offset(p_sprite, p_sprite->frame_cnt, 0);
+}
+
+static void
+shift_xbm(uint8_t *p_dst, const uint8_t *xbm, uint8_t w, uint8_t h,
+    uint8_t frame, uint8_t phase)
+{
+    uint16_t pages = (uint16_t)((h + phase + 7) / 8);
+    uint16_t stride = (uint16_t)((w + 7) / 8);
+    const uint8_t *p_row;
+    uint8_t byte;
+    int16_t row;
+
+    for (uint16_t page = 0; page < pages; page++)
+    {
+        for (uint8_t col = 0; col < w; col++)
+        {
+            byte = 0;
+            for (uint8_t bit = 0; bit < 8; bit++)
+            {
+                row = (int16_t)(page * 8 + bit - phase);
+                if ((row < 0) || (row >= h))
+                {
+                    continue;
+                }
+
+                // XBM rows are LSB first
+                p_row = xbm + ((size_t)frame * h + (size_t)row) * stride;
+                if (p_row[col / 8] & (1u << (col % 8)))
+                {
+                    byte |= (uint8_t)(1u << bit);
+                }
+            }
+            *p_dst++ = byte;
+        }
+    }
+}
+
+static void
+blit(u8g2_t *u8g2, lib_u8g2_sprite_t *p_sprite)
+{
+    const uint8_t *p_src;
+    const uint8_t *p_mask;
+    uint8_t *p_dst;
+    uint8_t *p_save;
+    size_t plane_len;
+    int16_t col0;
+    int16_t col1;
+    int16_t page0;
+    int16_t page1;
+    int16_t src_page;
+    uint8_t phase;
+
+    p_sprite->is_shown = 1;
+    p_sprite->save_w = 0;
+
+    if (!clip(u8g2, p_sprite, &col0, &col1, &page0, &page1, &phase))
+    {
+        return;
+    }
+
+    p_src = p_sprite->p_buf +
+        phase_offset(p_sprite, p_sprite->frame, phase);
+    plane_len = (size_t)p_sprite->w * ((p_sprite->h + phase + 7) / 8);
+    p_mask = p_sprite->has_mask ? p_src + plane_len : p_src;
+
+    if (p_sprite->mode != LIB_U8G2_SPRITE_XOR)
+    {
+        // Frame buffer bytes below sprite
+        p_sprite->save_x = col0;
+        p_sprite->save_page = page0;
+        p_sprite->save_w = (int16_t)(col1 - col0);
+        p_sprite->save_pages = (int16_t)(page1 - page0);
+        p_save = save_area(p_sprite);
+        for (int16_t page = page0; page < page1; page++)
+        {
+            memcpy(p_save, u8g2->tile_buf_ptr +
+                (size_t)page * u8g2->pixel_buf_width + col0,
+                (size_t)p_sprite->save_w);
+            p_save += p_sprite->save_w;
+        }
+    }
+
+    for (int16_t page = page0; page < page1; page++)
+    {
+        src_page = (int16_t)(page - (p_sprite->y - phase) / 8);
+        p_dst = u8g2->tile_buf_ptr + (size_t)page * u8g2->pixel_buf_width;
+
+        for (int16_t col = col0; col < col1; col++)
+        {
+            size_t idx = (size_t)src_page * p_sprite->w +
+                (size_t)(col - p_sprite->x);
+
+            switch (p_sprite->mode)
+            {
+            case LIB_U8G2_SPRITE_XOR:
+                p_dst[col] ^= p_src[idx];
+                break;
+            case LIB_U8G2_SPRITE_MASKED:
+                p_dst[col] = (uint8_t)((p_dst[col] & ~p_mask[idx]) |
+                    (p_src[idx] & p_mask[idx]));
+                break;
+            default:
+                p_dst[col] |= p_src[idx];
+                break;
+            }
+        }
+    }
+
+    lib_u8g2_MarkDirty(u8g2, col0, (int16_t)(page0 * 8), col1,
+        (int16_t)(page1 * 8));
+}
+
+static void
+erase(u8g2_t *u8g2, lib_u8g2_sprite_t *p_sprite)
+{
+    const uint8_t *p_save;
+
+    if (p_sprite->mode == LIB_U8G2_SPRITE_XOR)
+    {
+        // Second XOR restores background
+        blit(u8g2, p_sprite);
+    }
+    else if (p_sprite->save_w > 0)
+    {
+        p_save = save_area(p_sprite);
+        for (int16_t i = 0; i < p_sprite->save_pages; i++)
+        {
+            memcpy(u8g2->tile_buf_ptr + (size_t)(p_sprite->save_page + i) *
+                u8g2->pixel_buf_width + p_sprite->save_x, p_save,
+                (size_t)p_sprite->save_w);
+            p_save += p_sprite->save_w;
+        }
+
+        lib_u8g2_MarkDirty(u8g2, p_sprite->save_x,
+            (int16_t)(p_sprite->save_page * 8),
+            (int16_t)(p_sprite->save_x + p_sprite->save_w),
+            (int16_t)((p_sprite->save_page + p_sprite->save_pages) * 8));
+    }
+
+    p_sprite->is_shown = 0;
+}
+
+static uint8_t
+clip(u8g2_t *u8g2, const lib_u8g2_sprite_t *p_sprite, int16_t *p_col0,
+    int16_t *p_col1, int16_t *p_page0, int16_t *p_page1, uint8_t *p_phase)
+{
+    int16_t width = (int16_t)u8g2->pixel_buf_width;
+    int16_t page_cnt = (int16_t)u8g2->tile_buf_height;
+    int16_t y = p_sprite->y;
+
+    // Floor division, top page may be above display
+    *p_page0 = (int16_t)((y >= 0) ? (y / 8) : -((7 - y) / 8));
+    *p_phase = (uint8_t)(y - *p_page0 * 8);
+    *p_page1 = (int16_t)(*p_page0 + (p_sprite->h + *p_phase + 7) / 8);
+    *p_col0 = p_sprite->x;
+    *p_col1 = (int16_t)(p_sprite->x + p_sprite->w);
+
+    if (*p_page0 < 0)
+    {
+        *p_page0 = 0;
+    }
+    if (*p_page1 > page_cnt)
+    {
+        *p_page1 = page_cnt;
+    }
+    if (*p_col0 < 0)
+    {
+        *p_col0 = 0;
+    }
+    if (*p_col1 > width)
+    {
+        *p_col1 = width;
+    }
+
+    return (uint8_t)((*p_col0 < *p_col1) && (*p_page0 < *p_page1));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,139 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_stream.c
+* @version 1.0.0
+*
+* @brief Compressed images streamed to display without frame buffer.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <string.h>
+
+#include <lib_u8g2_stream.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+#define IMAGE_HEADER_SIZE       (3)
+#define RLE_RUN_FLAG            (0x80u)
+
+/*******************************************************************************
+* Private types
+*******************************************************************************/
+
+typedef struct
+{
+    const uint8_t *p_src;
+    uint8_t format;
+    uint8_t literal_cnt;    // Literal bytes left in current block
+    uint8_t run_cnt;        // Repeats left in current block
+    uint8_t run_value;
+} decoder_t;
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static void
+decode(decoder_t *p_dec, uint8_t *p_dst, uint16_t len);
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+uint8_t
+lib_u8g2_StreamImage(u8g2_t *u8g2, uint8_t tx, uint8_t ty,
+    const uint8_t *p_image)
+{
+    uint8_t tiles[LIB_U8G2_STREAM_CHUNK_TILES * 8];
+    decoder_t dec;
+    uint8_t width = p_image[1];
+    uint8_t height = p_image[2];
+    uint8_t cnt;
+
+    if ((p_image[0] != LIB_U8G2_STREAM_RAW) &&
+        (p_image[0] != LIB_U8G2_STREAM_RLE))
+    {
+        return 0;
+    }
+
+    memset(&dec, 0, sizeof(dec));
+    dec.p_src = p_image + IMAGE_HEADER_SIZE;
+    dec.format = p_image[0];
+
+    for (uint8_t row = 0; row < height; row++)
+    {
+        for (uint8_t col = 0; col < width; col = (uint8_t)(col + cnt))
+        {
+            cnt = (uint8_t)(width - col);
+            if (cnt > LIB_U8G2_STREAM_CHUNK_TILES)
+            {
+                cnt = LIB_U8G2_STREAM_CHUNK_TILES;
+            }
+
+            decode(&dec, tiles, (uint16_t)(cnt * 8));
+            u8x8_DrawTile(u8g2_GetU8x8(u8g2), (uint8_t)(tx + col),
+                (uint8_t)(ty + row), cnt, tiles);
+        }
+    }
+
+    return 1;
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static void
+decode(decoder_t *p_dec, uint8_t *p_dst, uint16_t len)
+{
+    uint8_t cnt;
+    uint8_t ctrl;
+
+    if (p_dec->format == LIB_U8G2_STREAM_RAW)
+    {
+        memcpy(p_dst, p_dec->p_src, len);
+        p_dec->p_src += len;
+        return;
+    }
+
+    while (len > 0)
+    {
+        if (p_dec->run_cnt > 0)
+        {
+            cnt = (len < p_dec->run_cnt) ? (uint8_t)len : p_dec->run_cnt;
+            memset(p_dst, p_dec->run_value, cnt);
+            p_dec->run_cnt = (uint8_t)(p_dec->run_cnt - cnt);
+        }
+        else if (p_dec->literal_cnt > 0)
+        {
+            cnt = (len < p_dec->literal_cnt) ? (uint8_t)len :
+                p_dec->literal_cnt;
+            memcpy(p_dst, p_dec->p_src, cnt);
+            p_dec->p_src += cnt;
+            p_dec->literal_cnt = (uint8_t)(p_dec->literal_cnt - cnt);
+        }
+        else
+        {
+            // Blocks may span chunk boundaries
+            ctrl = *p_dec->p_src++;
+            if (ctrl & RLE_RUN_FLAG)
+            {
+                p_dec->run_cnt = (uint8_t)((ctrl & ~RLE_RUN_FLAG) + 2);
+                p_dec->run_value = *p_dec->p_src++;
+            }
+            else
+            {
+                p_dec->literal_cnt = (uint8_t)(ctrl + 1);
+            }
+            continue;
+        }
+
+        p_dst += cnt;
+        len = (uint16_t)(len - cnt);
+    }
+}
+
+/* [] END OF FILE */
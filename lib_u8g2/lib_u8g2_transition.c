@@ -0,0 +1,294 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_transition.c
+* @version 1.0.0
+*
+* @brief Screen transitions using SSD1306 commands.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <lib_u8g2_transition.h>
+#include <lib_u8g2_scroll.h>
+#include <lib_u8g2_span.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+#define SSD1306_RAM_ROWS            (64)
+
+#define CMD_SET_START_LINE          (0x40)
+#define CMD_NORMAL_DISPLAY          (0xA6)
+#define CMD_INVERSE_DISPLAY         (0xA7)
+
+/*******************************************************************************
+* Private types
+*******************************************************************************/
+
+typedef struct
+{
+    lib_u8g2_transition_t type;
+    uint8_t step;           // Steps done
+    uint8_t steps;          // Steps total
+    uint8_t start_line;     // Slide start line at the beginning
+    uint8_t rows_done;      // Slide rows uncovered so far
+    uint8_t is_paged;       // Slide sends RAM pages in each step
+    uint8_t is_running;
+} transition_t;
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static void
+send_cmd(u8g2_t *u8g2, uint8_t cmd);
+
+static uint8_t
+slide_start(u8g2_t *u8g2);
+
+static void
+slide_step(u8g2_t *u8g2);
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+
+static uint8_t g_contrast = LIB_U8G2_TRANSITION_DEFAULT_CONTRAST;
+static uint8_t g_is_inverse;
+static transition_t g_transition;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void
+lib_u8g2_SetContrastLevel(u8g2_t *u8g2, uint8_t level)
+{
+    g_contrast = level;
+    u8g2_SetContrast(u8g2, level);
+}
+
+void
+lib_u8g2_SetInverse(u8g2_t *u8g2, uint8_t is_inverse)
+{
+    g_is_inverse = (uint8_t)(is_inverse != 0);
+    send_cmd(u8g2, g_is_inverse ? CMD_INVERSE_DISPLAY : CMD_NORMAL_DISPLAY);
+}
+
+uint8_t
+lib_u8g2_TransitionStart(u8g2_t *u8g2, lib_u8g2_transition_t type,
+    uint8_t steps)
+{
+    g_transition.type = type;
+    g_transition.step = 0;
+    g_transition.steps = (steps == 0) ? 1 : steps;
+    g_transition.is_running = 1;
+
+    if ((type == LIB_U8G2_TRANSITION_SLIDE_UP) ||
+        (type == LIB_U8G2_TRANSITION_SLIDE_DOWN))
+    {
+        return slide_start(u8g2);
+    }
+
+    return 1;
+}
+
+uint8_t
+lib_u8g2_TransitionStep(u8g2_t *u8g2)
+{
+    uint8_t step;
+    uint8_t steps = g_transition.steps;
+
+    if (!g_transition.is_running)
+    {
+        return 0;
+    }
+
+    step = ++g_transition.step;
+
+    switch (g_transition.type)
+    {
+    case LIB_U8G2_TRANSITION_FADE_OUT:
+        u8g2_SetContrast(u8g2,
+            (uint8_t)((uint16_t)g_contrast * (steps - step) / steps));
+        if (step == steps)
+        {
+            u8g2_SetPowerSave(u8g2, 1);
+        }
+        break;
+
+    case LIB_U8G2_TRANSITION_FADE_IN:
+        u8g2_SetContrast(u8g2,
+            (uint8_t)((uint16_t)g_contrast * step / steps));
+        if (step == 1)
+        {
+            u8g2_SetPowerSave(u8g2, 0);
+        }
+        break;
+
+    case LIB_U8G2_TRANSITION_FLASH:
+        // Odd steps show opposite of base state, last step restores it
+        send_cmd(u8g2, ((step & 1) && (step != steps)) != g_is_inverse ?
+            CMD_INVERSE_DISPLAY : CMD_NORMAL_DISPLAY);
+        break;
+
+    case LIB_U8G2_TRANSITION_SLIDE_UP:
+    case LIB_U8G2_TRANSITION_SLIDE_DOWN:
+        slide_step(u8g2);
+        break;
+
+    default:
+        g_transition.step = steps;
+        break;
+    }
+
+    if (g_transition.step >= steps)
+    {
+        g_transition.is_running = 0;
+    }
+
+    return g_transition.is_running;
+}
+
+uint8_t
+lib_u8g2_TransitionRun(u8g2_t *u8g2, lib_u8g2_transition_t type,
+    uint8_t steps, uint8_t step_ms)
+{
+    if (!lib_u8g2_TransitionStart(u8g2, type, steps))
+    {
+        return 0;
+    }
+
+    while (lib_u8g2_TransitionStep(u8g2))
+    {
+        u8x8_gpio_Delay(u8g2_GetU8x8(u8g2), U8X8_MSG_DELAY_MILLI, step_ms);
+    }
+
+    return 1;
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static void
+send_cmd(u8g2_t *u8g2, uint8_t cmd)
+{
+    u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+
+    u8x8_cad_StartTransfer(u8x8);
+    u8x8_cad_SendCmd(u8x8, cmd);
+    u8x8_cad_EndTransfer(u8x8);
+}
+
+static uint8_t
+slide_start(u8g2_t *u8g2)
+{
+    int16_t height = (int16_t)(u8g2->tile_buf_height * 8);
+    int16_t width = (int16_t)u8g2->pixel_buf_width;
+    uint8_t start_line = lib_u8g2_GetStartLine();
+    uint8_t pages;
+
+    if (!lib_u8g2_IsSpanBuffer(u8g2) ||
+        (u8g2->tile_buf_height != u8x8_GetRows(u8g2_GetU8x8(u8g2))) ||
+        (height > SSD1306_RAM_ROWS))
+    {
+        g_transition.is_running = 0;
+        return 0;
+    }
+
+    if ((start_line & 7) != 0)
+    {
+        // RAM pages hold rows of both screens, switch without sliding
+        lib_u8g2_ScrollSendArea(u8g2, 0, 0, width, height);
+        g_transition.is_running = 0;
+        return 1;
+    }
+
+    g_transition.start_line = start_line;
+    g_transition.rows_done = 0;
+
+    // New screen ends up shown from start line moved by display height
+    if (g_transition.type == LIB_U8G2_TRANSITION_SLIDE_UP)
+    {
+        start_line = (uint8_t)((start_line + height) % SSD1306_RAM_ROWS);
+    }
+    else
+    {
+        start_line = (uint8_t)((start_line + SSD1306_RAM_ROWS - height) %
+            SSD1306_RAM_ROWS);
+    }
+    lib_u8g2_SetStartLine(start_line);
+
+    if (2 * height <= SSD1306_RAM_ROWS)
+    {
+        // New screen fits to hidden RAM rows, steps move start line only
+        g_transition.is_paged = 0;
+        lib_u8g2_ScrollSendArea(u8g2, 0, 0, width, height);
+    }
+    else
+    {
+        // Screen is uncovered by whole pages
+        g_transition.is_paged = 1;
+        pages = (uint8_t)(height / 8);
+        if (g_transition.steps > pages)
+        {
+            g_transition.steps = pages;
+        }
+    }
+
+    return 1;
+}
+
+static void
+slide_step(u8g2_t *u8g2)
+{
+    int16_t height = (int16_t)(u8g2->tile_buf_height * 8);
+    int16_t width = (int16_t)u8g2->pixel_buf_width;
+    int16_t rows;
+    uint8_t start_line;
+
+    if (g_transition.is_paged)
+    {
+        // Rounded up to whole pages
+        rows = (int16_t)(((height / 8) * g_transition.step +
+            g_transition.steps - 1) / g_transition.steps * 8);
+    }
+    else
+    {
+        rows = (int16_t)(height * g_transition.step / g_transition.steps);
+    }
+
+    if (g_transition.type == LIB_U8G2_TRANSITION_SLIDE_UP)
+    {
+        start_line = (uint8_t)((g_transition.start_line + rows) %
+            SSD1306_RAM_ROWS);
+    }
+    else
+    {
+        start_line = (uint8_t)((g_transition.start_line +
+            SSD1306_RAM_ROWS - rows) % SSD1306_RAM_ROWS);
+    }
+    send_cmd(u8g2, (uint8_t)(CMD_SET_START_LINE | start_line));
+
+    if (g_transition.is_paged)
+    {
+        // RAM pages just moved to display, start line already maps frame
+        // buffer rows to them
+        if (g_transition.type == LIB_U8G2_TRANSITION_SLIDE_UP)
+        {
+            lib_u8g2_ScrollSendArea(u8g2, 0, g_transition.rows_done, width,
+                rows);
+        }
+        else
+        {
+            lib_u8g2_ScrollSendArea(u8g2, 0, (int16_t)(height - rows), width,
+                (int16_t)(height - g_transition.rows_done));
+        }
+    }
+
+    g_transition.rows_done = (uint8_t)rows;
+}
+
+/* [] END OF FILE */
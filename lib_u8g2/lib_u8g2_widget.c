@@ -0,0 +1,455 @@
+﻿/***************************************************************************//**
+* @file    lib_u8g2_widget.c
+* @version 1.0.0
+*
+* @brief Retained mode widgets with per-widget dirty rectangles.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <string.h>
+
+#include <lib_u8g2_widget.h>
+#include <lib_u8g2_dirty.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+#define PROGRESS_BORDER         (2)     // Frame and gap around progress bar
+
+/*******************************************************************************
+* Forward declarations of private functions
+*******************************************************************************/
+
+static void
+init_widget(lib_u8g2_widget_t *p_widget, lib_u8g2_widget_type_t type,
+    int16_t x, int16_t y, int16_t w, int16_t h);
+
+static void
+mark_dirty(lib_u8g2_widget_t *p_widget, int16_t x0, int16_t x1);
+
+static void
+set_text(lib_u8g2_widget_t *p_widget, const char *text);
+
+static void
+format_number(char *p_buf, int32_t value, uint8_t decimals);
+
+static void
+draw_widget(u8g2_t *u8g2, const lib_u8g2_widget_t *p_widget);
+
+static void
+draw_clipped(u8g2_t *u8g2, const lib_u8g2_widget_t *p_widget, int16_t x0,
+    int16_t y0, int16_t x1, int16_t y1);
+
+static uint8_t
+intersect(int16_t *p_x0, int16_t *p_y0, int16_t *p_x1, int16_t *p_y1,
+    int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+void
+lib_u8g2_ScreenInit(lib_u8g2_screen_t *p_screen)
+{
+    p_screen->p_first = NULL;
+    p_screen->p_last = NULL;
+}
+
+void
+lib_u8g2_ScreenAdd(lib_u8g2_screen_t *p_screen, lib_u8g2_widget_t *p_widget)
+{
+    p_widget->p_next = NULL;
+    if (p_screen->p_last == NULL)
+    {
+        p_screen->p_first = p_widget;
+    }
+    else
+    {
+        p_screen->p_last->p_next = p_widget;
+    }
+    p_screen->p_last = p_widget;
+}
+
+void
+lib_u8g2_ScreenDraw(u8g2_t *u8g2, lib_u8g2_screen_t *p_screen)
+{
+    const uint8_t *font = u8g2->font;
+    uint8_t color = u8g2->draw_color;
+
+    u8g2_ClearBuffer(u8g2);
+    u8g2_SetDrawColor(u8g2, 1);
+
+    for (lib_u8g2_widget_t *p_widget = p_screen->p_first; p_widget != NULL;
+        p_widget = p_widget->p_next)
+    {
+        draw_clipped(u8g2, p_widget, 0, 0,
+            (int16_t)u8g2_GetDisplayWidth(u8g2),
+            (int16_t)u8g2_GetDisplayHeight(u8g2));
+        p_widget->dirty_x1 = p_widget->dirty_x0;
+    }
+
+    u8g2_SetMaxClipWindow(u8g2);
+    u8g2_SetDrawColor(u8g2, color);
+    if (font != NULL)
+    {
+        u8g2_SetFont(u8g2, font);
+    }
+}
+
+uint8_t
+lib_u8g2_ScreenUpdate(u8g2_t *u8g2, lib_u8g2_screen_t *p_screen)
+{
+    const uint8_t *font = u8g2->font;
+    uint8_t color = u8g2->draw_color;
+    int16_t width = (int16_t)u8g2_GetDisplayWidth(u8g2);
+    int16_t height = (int16_t)u8g2_GetDisplayHeight(u8g2);
+    uint8_t is_updated = 0;
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+
+    // Each dirty rectangle is flushed on its own, so distant widgets do not
+    // resend the area between them
+    for (lib_u8g2_widget_t *p_dirty = p_screen->p_first; p_dirty != NULL;
+        p_dirty = p_dirty->p_next)
+    {
+        if (p_dirty->dirty_x0 >= p_dirty->dirty_x1)
+        {
+            continue;
+        }
+
+        x0 = p_dirty->dirty_x0;
+        y0 = p_dirty->y;
+        x1 = p_dirty->dirty_x1;
+        y1 = (int16_t)(p_dirty->y + p_dirty->h);
+        p_dirty->dirty_x1 = p_dirty->dirty_x0;
+        if (!intersect(&x0, &y0, &x1, &y1, 0, 0, width, height))
+        {
+            continue;
+        }
+
+        // Clear dirty rectangle and redraw widgets touching it, overlapping
+        // widgets included
+        u8g2_SetClipWindow(u8g2, (u8g2_uint_t)x0, (u8g2_uint_t)y0,
+            (u8g2_uint_t)x1, (u8g2_uint_t)y1);
+        u8g2_SetDrawColor(u8g2, 0);
+        u8g2_DrawBox(u8g2, (u8g2_uint_t)x0, (u8g2_uint_t)y0,
+            (u8g2_uint_t)(x1 - x0), (u8g2_uint_t)(y1 - y0));
+        u8g2_SetDrawColor(u8g2, 1);
+
+        for (lib_u8g2_widget_t *p_widget = p_screen->p_first;
+            p_widget != NULL; p_widget = p_widget->p_next)
+        {
+            draw_clipped(u8g2, p_widget, x0, y0, x1, y1);
+        }
+
+        // Send tiles covering dirty rectangle, with tracking active redraw
+        // was recorded and sending through tracking keeps it consistent
+        if (lib_u8g2_GetTrackedHvline() != NULL)
+        {
+            lib_u8g2_SendDirty(u8g2);
+        }
+        else
+        {
+            u8g2_UpdateDisplayArea(u8g2, (uint8_t)(x0 / 8), (uint8_t)(y0 / 8),
+                (uint8_t)((x1 + 7) / 8 - x0 / 8),
+                (uint8_t)((y1 + 7) / 8 - y0 / 8));
+        }
+        is_updated = 1;
+    }
+
+    u8g2_SetMaxClipWindow(u8g2);
+    u8g2_SetDrawColor(u8g2, color);
+    if (font != NULL)
+    {
+        u8g2_SetFont(u8g2, font);
+    }
+
+    return is_updated;
+}
+
+void
+lib_u8g2_InitLabel(lib_u8g2_widget_t *p_widget, int16_t x, int16_t y,
+    int16_t w, int16_t h, const uint8_t *font, lib_u8g2_align_t align,
+    const char *text)
+{
+    init_widget(p_widget, LIB_U8G2_WIDGET_LABEL, x, y, w, h);
+    p_widget->data.text.font = font;
+    p_widget->data.text.align = align;
+    p_widget->data.text.text[0] = '\0';
+    set_text(p_widget, text);
+}
+
+void
+lib_u8g2_InitNumber(lib_u8g2_widget_t *p_widget, int16_t x, int16_t y,
+    int16_t w, int16_t h, const uint8_t *font, lib_u8g2_align_t align,
+    uint8_t decimals)
+{
+    init_widget(p_widget, LIB_U8G2_WIDGET_NUMBER, x, y, w, h);
+    p_widget->data.text.font = font;
+    p_widget->data.text.align = align;
+    p_widget->data.text.decimals = decimals;
+    format_number(p_widget->data.text.text, 0, decimals);
+}
+
+void
+lib_u8g2_InitBitmap(lib_u8g2_widget_t *p_widget, int16_t x, int16_t y,
+    int16_t w, int16_t h, const uint8_t *bitmap)
+{
+    init_widget(p_widget, LIB_U8G2_WIDGET_BITMAP, x, y, w, h);
+    p_widget->data.bitmap = bitmap;
+}
+
+void
+lib_u8g2_InitProgress(lib_u8g2_widget_t *p_widget, int16_t x, int16_t y,
+    int16_t w, int16_t h, uint16_t max)
+{
+    init_widget(p_widget, LIB_U8G2_WIDGET_PROGRESS, x, y, w, h);
+    p_widget->data.progress.value = 0;
+    p_widget->data.progress.max = (max == 0) ? 1 : max;
+    p_widget->data.progress.fill_w = 0;
+}
+
+void
+lib_u8g2_InitFrame(lib_u8g2_widget_t *p_widget, int16_t x, int16_t y,
+    int16_t w, int16_t h)
+{
+    init_widget(p_widget, LIB_U8G2_WIDGET_FRAME, x, y, w, h);
+}
+
+void
+lib_u8g2_SetLabel(lib_u8g2_widget_t *p_widget, const char *text)
+{
+    set_text(p_widget, text);
+}
+
+void
+lib_u8g2_SetNumber(lib_u8g2_widget_t *p_widget, int32_t value)
+{
+    char text[LIB_U8G2_WIDGET_TEXT_SIZE];
+
+    format_number(text, value, p_widget->data.text.decimals);
+    set_text(p_widget, text);
+}
+
+void
+lib_u8g2_SetBitmap(lib_u8g2_widget_t *p_widget, const uint8_t *bitmap)
+{
+    if (p_widget->data.bitmap != bitmap)
+    {
+        p_widget->data.bitmap = bitmap;
+        lib_u8g2_InvalidateWidget(p_widget);
+    }
+}
+
+void
+lib_u8g2_SetProgress(lib_u8g2_widget_t *p_widget, uint16_t value)
+{
+    int16_t bar_w = (int16_t)(p_widget->w - 2 * PROGRESS_BORDER);
+    int16_t fill_w;
+    int16_t bar_x = (int16_t)(p_widget->x + PROGRESS_BORDER);
+
+    if (value > p_widget->data.progress.max)
+    {
+        value = p_widget->data.progress.max;
+    }
+    p_widget->data.progress.value = value;
+
+    if (bar_w <= 0)
+    {
+        return;
+    }
+
+    // Only columns between old and new bar end change
+    fill_w = (int16_t)((int32_t)bar_w * value / p_widget->data.progress.max);
+    if (fill_w > p_widget->data.progress.fill_w)
+    {
+        mark_dirty(p_widget, (int16_t)(bar_x + p_widget->data.progress.fill_w),
+            (int16_t)(bar_x + fill_w));
+    }
+    else if (fill_w < p_widget->data.progress.fill_w)
+    {
+        mark_dirty(p_widget, (int16_t)(bar_x + fill_w),
+            (int16_t)(bar_x + p_widget->data.progress.fill_w));
+    }
+    p_widget->data.progress.fill_w = fill_w;
+}
+
+void
+lib_u8g2_InvalidateWidget(lib_u8g2_widget_t *p_widget)
+{
+    mark_dirty(p_widget, p_widget->x, (int16_t)(p_widget->x + p_widget->w));
+}
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static void
+init_widget(lib_u8g2_widget_t *p_widget, lib_u8g2_widget_type_t type,
+    int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    memset(p_widget, 0, sizeof(lib_u8g2_widget_t));
+    p_widget->type = type;
+    p_widget->x = x;
+    p_widget->y = y;
+    p_widget->w = w;
+    p_widget->h = h;
+    lib_u8g2_InvalidateWidget(p_widget);
+}
+
+static void
+mark_dirty(lib_u8g2_widget_t *p_widget, int16_t x0, int16_t x1)
+{
+    if (p_widget->dirty_x0 >= p_widget->dirty_x1)
+    {
+        p_widget->dirty_x0 = x0;
+        p_widget->dirty_x1 = x1;
+        return;
+    }
+
+    if (x0 < p_widget->dirty_x0)
+    {
+        p_widget->dirty_x0 = x0;
+    }
+    if (x1 > p_widget->dirty_x1)
+    {
+        p_widget->dirty_x1 = x1;
+    }
+}
+
+static void
+set_text(lib_u8g2_widget_t *p_widget, const char *text)
+{
+    if (strncmp(p_widget->data.text.text, text,
+        LIB_U8G2_WIDGET_TEXT_SIZE - 1) != 0)
+    {
+        strncpy(p_widget->data.text.text, text,
+            LIB_U8G2_WIDGET_TEXT_SIZE - 1);
+        p_widget->data.text.text[LIB_U8G2_WIDGET_TEXT_SIZE - 1] = '\0';
+        lib_u8g2_InvalidateWidget(p_widget);
+    }
+}
+
+static void
+format_number(char *p_buf, int32_t value, uint8_t decimals)
+{
+    char digits[12];
+    uint32_t magnitude = (value < 0) ? 0u - (uint32_t)value : (uint32_t)value;
+    uint8_t cnt = 0;
+    uint8_t pos = 0;
+
+    // Digits in reverse order, at least one before decimal point
+    do
+    {
+        digits[cnt++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (((magnitude > 0) || (cnt <= decimals)) && (cnt < sizeof(digits)));
+
+    if (value < 0)
+    {
+        p_buf[pos++] = '-';
+    }
+    while ((cnt > 0) && (pos < LIB_U8G2_WIDGET_TEXT_SIZE - 2))
+    {
+        if ((cnt == decimals) && (decimals > 0))
+        {
+            p_buf[pos++] = '.';
+        }
+        p_buf[pos++] = digits[--cnt];
+    }
+    p_buf[pos] = '\0';
+}
+
+static void
+draw_widget(u8g2_t *u8g2, const lib_u8g2_widget_t *p_widget)
+{
+    int16_t x = p_widget->x;
+    int16_t text_w;
+
+    switch (p_widget->type)
+    {
+    case LIB_U8G2_WIDGET_LABEL:
+    case LIB_U8G2_WIDGET_NUMBER:
+        u8g2_SetFont(u8g2, p_widget->data.text.font);
+        text_w = (int16_t)u8g2_GetStrWidth(u8g2, p_widget->data.text.text);
+        if (p_widget->data.text.align == LIB_U8G2_ALIGN_CENTER)
+        {
+            x = (int16_t)(x + (p_widget->w - text_w) / 2);
+        }
+        else if (p_widget->data.text.align == LIB_U8G2_ALIGN_RIGHT)
+        {
+            x = (int16_t)(x + p_widget->w - text_w);
+        }
+        u8g2_DrawStr(u8g2, (u8g2_uint_t)x,
+            (u8g2_uint_t)(p_widget->y + u8g2_GetAscent(u8g2)),
+            p_widget->data.text.text);
+        break;
+
+    case LIB_U8G2_WIDGET_BITMAP:
+        if (p_widget->data.bitmap != NULL)
+        {
+            u8g2_DrawXBM(u8g2, (u8g2_uint_t)p_widget->x,
+                (u8g2_uint_t)p_widget->y, (u8g2_uint_t)p_widget->w,
+                (u8g2_uint_t)p_widget->h, p_widget->data.bitmap);
+        }
+        break;
+
+    case LIB_U8G2_WIDGET_PROGRESS:
+        u8g2_DrawFrame(u8g2, (u8g2_uint_t)p_widget->x,
+            (u8g2_uint_t)p_widget->y, (u8g2_uint_t)p_widget->w,
+            (u8g2_uint_t)p_widget->h);
+        if ((p_widget->data.progress.fill_w > 0) &&
+            (p_widget->h > 2 * PROGRESS_BORDER))
+        {
+            u8g2_DrawBox(u8g2, (u8g2_uint_t)(p_widget->x + PROGRESS_BORDER),
+                (u8g2_uint_t)(p_widget->y + PROGRESS_BORDER),
+                (u8g2_uint_t)p_widget->data.progress.fill_w,
+                (u8g2_uint_t)(p_widget->h - 2 * PROGRESS_BORDER));
+        }
+        break;
+
+    case LIB_U8G2_WIDGET_FRAME:
+        u8g2_DrawFrame(u8g2, (u8g2_uint_t)p_widget->x,
+            (u8g2_uint_t)p_widget->y, (u8g2_uint_t)p_widget->w,
+            (u8g2_uint_t)p_widget->h);
+        break;
+
+    default:
+        break;
+    }
+}
+
+static void
+draw_clipped(u8g2_t *u8g2, const lib_u8g2_widget_t *p_widget, int16_t x0,
+    int16_t y0, int16_t x1, int16_t y1)
+{
+    // Widget is drawn only inside its box, so clearing the box erases
+    // also longer text shown before
+    if (intersect(&x0, &y0, &x1, &y1, p_widget->x, p_widget->y,
+        (int16_t)(p_widget->x + p_widget->w),
+        (int16_t)(p_widget->y + p_widget->h)))
+    {
+        u8g2_SetClipWindow(u8g2, (u8g2_uint_t)x0, (u8g2_uint_t)y0,
+            (u8g2_uint_t)x1, (u8g2_uint_t)y1);
+        draw_widget(u8g2, p_widget);
+    }
+}
+
+static uint8_t
+intersect(int16_t *p_x0, int16_t *p_y0, int16_t *p_x1, int16_t *p_y1,
+    int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    *p_x0 = (*p_x0 < x0) ? x0 : *p_x0;
+    *p_y0 = (*p_y0 < y0) ? y0 : *p_y0;
+    *p_x1 = (*p_x1 > x1) ? x1 : *p_x1;
+    *p_y1 = (*p_y1 > y1) ? y1 : *p_y1;
+
+    return (uint8_t)((*p_x0 < *p_x1) && (*p_y0 < *p_y1));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,799 @@
+/***************************************************************************//**
+* @file    u8g2_font_subset.c
+* @version 1.0.0
+*
+* @brief Host tool creating u8g2 font subsets with only the glyphs in use.
+*
+* Reads a u8g2 font from C source (for example u8g2/csrc/u8g2_fonts.c),
+* keeps glyphs listed on command line or found in application strings and
+* writes the subset font as C source to stdout. Size saving is reported
+* to stderr.
+*
+* Build:
+*    gcc -O2 -o u8g2_font_subset u8g2_font_subset.c
+*
+* Usage:
+*    u8g2_font_subset [options] <font.c> <font_name> > subset.c
+*
+*    -g <list>   Glyph list, e.g. "32-126,0x2603,$2600-$26FF"
+*    -c <file>   Use characters of all string literals in C source file,
+*                literals are decoded as UTF-8 (for u8g2_DrawUTF8())
+*    -b <file>   Same as -c, each literal byte is one character (for
+*                u8g2_DrawStr() with 8-bit, e.g. Latin-1, strings)
+*    -t <file>   Use characters of UTF-8 text file
+*    -n <name>   Name of generated font (default <font_name>_subset)
+*
+* Options -g, -c, -b and -t may be repeated.
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+#define FONT_HEADER_SIZE        (23)    // U8G2_FONT_DATA_STRUCT_SIZE
+#define FONT_OFFSET_UPPER_A     (17)
+#define FONT_OFFSET_LOWER_A     (19)
+#define FONT_OFFSET_UNICODE     (21)
+
+#define UNICODE_BLOCK_GLYPHS    (32)    // Glyphs per Unicode jump table entry
+#define OUTPUT_LINE_LENGTH      (100)
+
+/*******************************************************************************
+* Private types
+*******************************************************************************/
+
+typedef struct
+{
+    uint8_t *data;
+    size_t len;
+    size_t size;
+} buffer_t;
+
+typedef struct
+{
+    uint16_t encoding;
+    const uint8_t *record;  // Complete glyph record including header
+    uint8_t record_len;
+} glyph_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+
+static uint8_t g_wanted[0x10000 / 8];  // Bitmap of requested encodings
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static void
+fatal(const char *msg, const char *arg)
+{
+    fprintf(stderr, "u8g2_font_subset: %s%s%s\n", msg,
+        (arg != NULL) ? ": " : "", (arg != NULL) ? arg : "");
+    exit(EXIT_FAILURE);
+}
+
+static void
+buffer_add(buffer_t *buf, uint8_t byte)
+{
+    if (buf->len == buf->size)
+    {
+        buf->size = (buf->size == 0) ? 4096 : buf->size * 2;
+        buf->data = realloc(buf->data, buf->size);
+        if (buf->data == NULL)
+        {
+            fatal("out of memory", NULL);
+        }
+    }
+    buf->data[buf->len++] = byte;
+}
+
+static char *
+read_file(const char *path, size_t *p_len)
+{
+    FILE *fp;
+    char *text;
+    long len;
+
+    fp = fopen(path, "rb");
+    if (fp == NULL)
+    {
+        fatal("can not open file", path);
+    }
+
+    fseek(fp, 0, SEEK_END);
+    len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    text = malloc((size_t)len + 1);
+    if ((text == NULL) || (fread(text, 1, (size_t)len, fp) != (size_t)len))
+    {
+        fatal("can not read file", path);
+    }
+    text[len] = '\0';
+    fclose(fp);
+
+    if (p_len != NULL)
+    {
+        *p_len = (size_t)len;
+    }
+    return text;
+}
+
+static void
+want(uint32_t encoding)
+{
+    if (encoding < 0x10000)
+    {
+        g_wanted[encoding / 8] |= (uint8_t)(1u << (encoding % 8));
+    }
+}
+
+static int
+is_wanted(uint16_t encoding)
+{
+    return (g_wanted[encoding / 8] & (1u << (encoding % 8))) != 0;
+}
+
+/**
+ * Parse C string literal starting after the opening quote, append decoded
+ * bytes to buffer and return pointer after the closing quote.
+ */
+static const char *
+parse_literal(const char *p, buffer_t *buf)
+{
+    unsigned long val;
+    int digits;
+
+    while ((*p != '"') && (*p != '\0'))
+    {
+        if (*p != '\\')
+        {
+            buffer_add(buf, (uint8_t)*p++);
+            continue;
+        }
+
+        p++;
+        switch (*p)
+        {
+            case 'n': buffer_add(buf, '\n'); p++; break;
+            case 't': buffer_add(buf, '\t'); p++; break;
+            case 'r': buffer_add(buf, '\r'); p++; break;
+            case 'a': buffer_add(buf, '\a'); p++; break;
+            case 'b': buffer_add(buf, '\b'); p++; break;
+            case 'f': buffer_add(buf, '\f'); p++; break;
+            case 'v': buffer_add(buf, '\v'); p++; break;
+
+            case 'x':
+                p++;
+                val = 0;
+                while (isxdigit((unsigned char)*p))
+                {
+                    val = val * 16 + (unsigned long)(isdigit((unsigned char)*p)
+                        ? *p - '0' : (tolower((unsigned char)*p) - 'a' + 10));
+                    p++;
+                }
+                buffer_add(buf, (uint8_t)val);
+            break;
+
+            case 'u':
+            case 'U':
+                // Universal character name, stored as UTF-8
+                digits = (*p == 'u') ? 4 : 8;
+                p++;
+                val = 0;
+                while ((digits-- > 0) && isxdigit((unsigned char)*p))
+                {
+                    val = val * 16 + (unsigned long)(isdigit((unsigned char)*p)
+                        ? *p - '0' : (tolower((unsigned char)*p) - 'a' + 10));
+                    p++;
+                }
+                if (val < 0x80)
+                {
+                    buffer_add(buf, (uint8_t)val);
+                }
+                else if (val < 0x800)
+                {
+                    buffer_add(buf, (uint8_t)(0xC0 | (val >> 6)));
+                    buffer_add(buf, (uint8_t)(0x80 | (val & 0x3F)));
+                }
+                else
+                {
+                    // Code points above BMP are not supported by u8g2
+                    buffer_add(buf, (uint8_t)(0xE0 | ((val >> 12) & 0x0F)));
+                    buffer_add(buf, (uint8_t)(0x80 | ((val >> 6) & 0x3F)));
+                    buffer_add(buf, (uint8_t)(0x80 | (val & 0x3F)));
+                }
+            break;
+
+            default:
+                if ((*p >= '0') && (*p <= '7'))
+                {
+                    val = 0;
+                    for (digits = 0; (digits < 3) && (*p >= '0') &&
+                        (*p <= '7'); digits++)
+                    {
+                        val = val * 8 + (unsigned long)(*p++ - '0');
+                    }
+                    buffer_add(buf, (uint8_t)val);
+                }
+                else if (*p != '\0')
+                {
+                    // \" \\ \' \? and line continuation
+                    if (*p != '\n')
+                    {
+                        buffer_add(buf, (uint8_t)*p);
+                    }
+                    p++;
+                }
+            break;
+        }
+    }
+
+    return (*p == '"') ? p + 1 : p;
+}
+
+/**
+ * Extract font data array of given name from u8g2 font C source.
+ */
+static void
+load_font(const char *path, const char *name, buffer_t *font)
+{
+    char *text = read_file(path, NULL);
+    const char *p = text;
+    size_t name_len = strlen(name);
+
+    // Find "<name>[" not being part of a longer identifier
+    for (;;)
+    {
+        p = strstr(p, name);
+        if (p == NULL)
+        {
+            fatal("font not found", name);
+        }
+        if (((p == text) || !(isalnum((unsigned char)p[-1]) || (p[-1] == '_')))
+            && (p[name_len] == '['))
+        {
+            break;
+        }
+        p += name_len;
+    }
+
+    p = strchr(p, '=');
+    if (p == NULL)
+    {
+        fatal("font data not found", name);
+    }
+
+    // Concatenate all string literals up to the terminating semicolon
+    while ((*p != ';') && (*p != '\0'))
+    {
+        if (*p == '"')
+        {
+            p = parse_literal(p + 1, font);
+        }
+        else
+        {
+            p++;
+        }
+    }
+
+    free(text);
+
+    if (font->len < FONT_HEADER_SIZE)
+    {
+        fatal("font data too short", name);
+    }
+}
+
+/**
+ * Parse decimal, 0x hex or bdfconv style $hex number of glyph list.
+ */
+static unsigned long
+parse_number(const char **p_p, const char *list)
+{
+    const char *digits = *p_p + ((**p_p == '$') ? 1 : 0);
+    char *end;
+    unsigned long val;
+
+    // strtoul() would skip white space and accept sign
+    if (!isxdigit((unsigned char)*digits))
+    {
+        fatal("invalid glyph list", list);
+    }
+
+    val = strtoul(digits, &end, (digits != *p_p) ? 16 : 0);
+    if (end == digits)
+    {
+        fatal("invalid glyph list", list);
+    }
+    *p_p = end;
+
+    return val;
+}
+
+static void
+add_glyph_list(const char *list)
+{
+    const char *p = list;
+    unsigned long first;
+    unsigned long last;
+
+    while (*p != '\0')
+    {
+        if ((*p == ',') || isspace((unsigned char)*p))
+        {
+            p++;
+            continue;
+        }
+
+        first = parse_number(&p, list);
+
+        last = first;
+        if (*p == '-')
+        {
+            p++;
+            last = parse_number(&p, list);
+        }
+
+        for (unsigned long e = first; (e <= last) && (e < 0x10000); e++)
+        {
+            want((uint32_t)e);
+        }
+    }
+}
+
+static void
+add_utf8(const uint8_t *s, size_t len)
+{
+    size_t i = 0;
+    uint32_t code;
+    int follow;
+
+    while (i < len)
+    {
+        if (s[i] < 0x80)
+        {
+            code = s[i];
+            follow = 0;
+        }
+        else if ((s[i] & 0xE0) == 0xC0)
+        {
+            code = s[i] & 0x1Fu;
+            follow = 1;
+        }
+        else if ((s[i] & 0xF0) == 0xE0)
+        {
+            code = s[i] & 0x0Fu;
+            follow = 2;
+        }
+        else if ((s[i] & 0xF8) == 0xF0)
+        {
+            code = s[i] & 0x07u;
+            follow = 3;
+        }
+        else
+        {
+            i++;
+            continue;
+        }
+        i++;
+
+        while ((follow > 0) && (i < len) && ((s[i] & 0xC0) == 0x80))
+        {
+            code = (code << 6) | (s[i] & 0x3Fu);
+            follow--;
+            i++;
+        }
+
+        // Control characters are never drawn
+        if ((follow == 0) && (code >= 0x20))
+        {
+            want(code);
+        }
+    }
+}
+
+static void
+add_bytes(const uint8_t *s, size_t len)
+{
+    // Control characters are never drawn
+    for (size_t i = 0; i < len; i++)
+    {
+        if (s[i] >= 0x20)
+        {
+            want(s[i]);
+        }
+    }
+}
+
+static void
+add_text_file(const char *path)
+{
+    size_t len;
+    char *text = read_file(path, &len);
+
+    add_utf8((const uint8_t *)text, len);
+    free(text);
+}
+
+static void
+add_c_strings(const char *path, int is_utf8)
+{
+    char *text = read_file(path, NULL);
+    const char *p = text;
+    buffer_t str = { 0 };
+
+    while (*p != '\0')
+    {
+        if ((p[0] == '/') && (p[1] == '*'))
+        {
+            p = strstr(p + 2, "*/");
+            p = (p == NULL) ? "" : p + 2;
+        }
+        else if ((p[0] == '/') && (p[1] == '/'))
+        {
+            while ((*p != '\n') && (*p != '\0'))
+            {
+                p++;
+            }
+        }
+        else if (*p == '\'')
+        {
+            // Skip character literal
+            p++;
+            while ((*p != '\'') && (*p != '\0'))
+            {
+                p += ((p[0] == '\\') && (p[1] != '\0')) ? 2 : 1;
+            }
+            if (*p != '\0')
+            {
+                p++;
+            }
+        }
+        else if ((*p == '#') && (strncmp(p, "#include", 8) == 0))
+        {
+            // Do not count include file names
+            while ((*p != '\n') && (*p != '\0'))
+            {
+                p++;
+            }
+        }
+        else if (*p == '"')
+        {
+            str.len = 0;
+            p = parse_literal(p + 1, &str);
+            if (is_utf8)
+            {
+                add_utf8(str.data, str.len);
+            }
+            else
+            {
+                add_bytes(str.data, str.len);
+            }
+        }
+        else
+        {
+            p++;
+        }
+    }
+
+    free(str.data);
+    free(text);
+}
+
+static uint16_t
+get_word(const uint8_t *p)
+{
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static void
+put_word(uint8_t *p, uint16_t val)
+{
+    p[0] = (uint8_t)(val >> 8);
+    p[1] = (uint8_t)(val & 0xFF);
+}
+
+/**
+ * Split font into 8-bit and Unicode glyph lists.
+ */
+static size_t
+collect_glyphs(const buffer_t *font, glyph_t *glyphs, size_t max,
+    size_t *p_total)
+{
+    const uint8_t *data = font->data + FONT_HEADER_SIZE;
+    const uint8_t *end = font->data + font->len;
+    const uint8_t *p = data;
+    const uint8_t *table;
+    size_t cnt = 0;
+    size_t total = 0;
+
+    // 8-bit glyphs: encoding, record size, glyph data
+    while ((p + 2 <= end) && (p[1] != 0))
+    {
+        if (is_wanted(p[0]) && (cnt < max))
+        {
+            glyphs[cnt].encoding = p[0];
+            glyphs[cnt].record = p;
+            glyphs[cnt].record_len = p[1];
+            cnt++;
+        }
+        total++;
+        p += p[1];
+    }
+
+    // Unicode glyphs: encoding (2 bytes), record size, glyph data
+    table = data + get_word(font->data + FONT_OFFSET_UNICODE);
+    if ((table >= p + 2) && (table + 4 <= end))
+    {
+        p = table + get_word(table);
+        while ((p + 3 <= end) && (get_word(p) != 0))
+        {
+            if (p[2] == 0)
+            {
+                fatal("corrupted font data", NULL);
+            }
+            if (is_wanted(get_word(p)) && (cnt < max))
+            {
+                glyphs[cnt].encoding = get_word(p);
+                glyphs[cnt].record = p;
+                glyphs[cnt].record_len = p[2];
+                cnt++;
+            }
+            total++;
+            p += p[2];
+        }
+    }
+
+    *p_total = total;
+    return cnt;
+}
+
+static void
+build_subset(const buffer_t *font, const glyph_t *glyphs, size_t cnt,
+    buffer_t *out)
+{
+    size_t i;
+    size_t first_unicode;
+    size_t table_pos;
+    size_t blocks;
+    size_t block_start;
+    uint16_t pos_upper_a = 0xFFFF;
+    uint16_t pos_lower_a = 0xFFFF;
+
+    // Header is copied, glyph count and offsets are updated below
+    for (i = 0; i < FONT_HEADER_SIZE; i++)
+    {
+        buffer_add(out, font->data[i]);
+    }
+    out->data[0] = (uint8_t)((cnt > 255) ? 255 : cnt);
+
+    for (i = 0; (i < cnt) && (glyphs[i].encoding <= 0xFF); i++)
+    {
+        if ((glyphs[i].encoding >= 'A') && (pos_upper_a == 0xFFFF))
+        {
+            pos_upper_a = (uint16_t)(out->len - FONT_HEADER_SIZE);
+        }
+        if ((glyphs[i].encoding >= 'a') && (pos_lower_a == 0xFFFF))
+        {
+            pos_lower_a = (uint16_t)(out->len - FONT_HEADER_SIZE);
+        }
+        for (size_t j = 0; j < glyphs[i].record_len; j++)
+        {
+            buffer_add(out, glyphs[i].record[j]);
+        }
+    }
+    first_unicode = i;
+
+    // Missing start positions point to end of 8-bit glyphs
+    if (pos_upper_a == 0xFFFF)
+    {
+        pos_upper_a = (uint16_t)(out->len - FONT_HEADER_SIZE);
+    }
+    if (pos_lower_a == 0xFFFF)
+    {
+        pos_lower_a = (uint16_t)(out->len - FONT_HEADER_SIZE);
+    }
+    put_word(out->data + FONT_OFFSET_UPPER_A, pos_upper_a);
+    put_word(out->data + FONT_OFFSET_LOWER_A, pos_lower_a);
+
+    // End of 8-bit glyphs
+    buffer_add(out, 0);
+    buffer_add(out, 0);
+
+    if (out->len - FONT_HEADER_SIZE > 0xFFFF)
+    {
+        fatal("8-bit glyph section too large", NULL);
+    }
+    put_word(out->data + FONT_OFFSET_UNICODE,
+        (uint16_t)(out->len - FONT_HEADER_SIZE));
+
+    // Unicode jump table, each entry holds offset to its glyph block and
+    // encoding of the last glyph in the block, the last entry ends with
+    // 0xFFFF
+    blocks = (cnt - first_unicode + UNICODE_BLOCK_GLYPHS - 1) /
+        UNICODE_BLOCK_GLYPHS;
+    if (blocks == 0)
+    {
+        blocks = 1;
+    }
+    table_pos = out->len;
+    for (i = 0; i < blocks * 4; i++)
+    {
+        buffer_add(out, 0);
+    }
+
+    block_start = table_pos;
+    for (size_t b = 0; b < blocks; b++)
+    {
+        size_t first = first_unicode + b * UNICODE_BLOCK_GLYPHS;
+        size_t last = first + UNICODE_BLOCK_GLYPHS;
+        size_t pos = out->len;
+
+        if (last > cnt)
+        {
+            last = cnt;
+        }
+        for (i = first; i < last; i++)
+        {
+            for (size_t j = 0; j < glyphs[i].record_len; j++)
+            {
+                buffer_add(out, glyphs[i].record[j]);
+            }
+        }
+
+        if (pos - block_start > 0xFFFF)
+        {
+            fatal("Unicode glyph block too large", NULL);
+        }
+        put_word(out->data + table_pos + b * 4, (uint16_t)(pos - block_start));
+        put_word(out->data + table_pos + b * 4 + 2, (b == blocks - 1) ?
+            0xFFFF : glyphs[last - 1].encoding);
+        block_start = pos;
+    }
+
+    // End of Unicode glyphs
+    buffer_add(out, 0);
+    buffer_add(out, 0);
+}
+
+static void
+write_font(const buffer_t *out, const char *name, const char *src_name,
+    size_t cnt, size_t total, size_t src_len)
+{
+    int col = 0;
+    int prev_octal = 0;
+    char tmp[8];
+    int len;
+
+    printf("/*\n  Subset of %s created by u8g2_font_subset\n"
+        "  Glyphs: %zu of %zu, size: %zu of %zu bytes\n*/\n",
+        src_name, cnt, total, out->len, src_len);
+    printf("const uint8_t %s[%zu] U8G2_FONT_SECTION(\"%s\") = \n  \"",
+        name, out->len, name);
+
+    for (size_t i = 0; i < out->len; i++)
+    {
+        uint8_t c = out->data[i];
+
+        // A digit after an octal escape would extend the escape sequence
+        if ((c >= 0x20) && (c < 0x7F) && (c != '"') && (c != '\\') &&
+            (c != '?') && !(prev_octal && isdigit(c)))
+        {
+            tmp[0] = (char)c;
+            tmp[1] = '\0';
+            len = 1;
+            prev_octal = 0;
+        }
+        else
+        {
+            len = snprintf(tmp, sizeof(tmp), "\\%o", c);
+            prev_octal = 1;
+        }
+
+        if (col + len > OUTPUT_LINE_LENGTH)
+        {
+            printf("\"\n  \"");
+            col = 0;
+            prev_octal = (len == 1) ? 0 : 1;
+        }
+        fputs(tmp, stdout);
+        col += len;
+    }
+
+    printf("\";\n");
+}
+
+static int
+compare_glyphs(const void *a, const void *b)
+{
+    return (int)((const glyph_t *)a)->encoding -
+        (int)((const glyph_t *)b)->encoding;
+}
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+int
+main(int argc, char *argv[])
+{
+    buffer_t font = { 0 };
+    buffer_t out = { 0 };
+    glyph_t *glyphs;
+    const char *out_name = NULL;
+    char name_buf[256];
+    size_t cnt;
+    size_t total;
+    int i;
+
+    for (i = 1; (i < argc) && (argv[i][0] == '-'); i += 2)
+    {
+        if ((i + 1 >= argc) || (argv[i][2] != '\0'))
+        {
+            fatal("invalid option", argv[i]);
+        }
+
+        switch (argv[i][1])
+        {
+            case 'g': add_glyph_list(argv[i + 1]); break;
+            case 'c': add_c_strings(argv[i + 1], 1); break;
+            case 'b': add_c_strings(argv[i + 1], 0); break;
+            case 't': add_text_file(argv[i + 1]); break;
+            case 'n': out_name = argv[i + 1]; break;
+            default: fatal("invalid option", argv[i]); break;
+        }
+    }
+
+    if (argc - i != 2)
+    {
+        fprintf(stderr, "Usage: u8g2_font_subset [-g list] [-c file.c] "
+            "[-b file.c] [-t file.txt] [-n name] <font.c> <font_name>\n");
+        return EXIT_FAILURE;
+    }
+
+    load_font(argv[i], argv[i + 1], &font);
+
+    if (out_name == NULL)
+    {
+        snprintf(name_buf, sizeof(name_buf), "%s_subset", argv[i + 1]);
+        out_name = name_buf;
+    }
+
+    // Font can not contain more glyphs than it has bytes
+    glyphs = malloc(font.len * sizeof(glyph_t));
+    if (glyphs == NULL)
+    {
+        fatal("out of memory", NULL);
+    }
+
+    cnt = collect_glyphs(&font, glyphs, font.len, &total);
+    qsort(glyphs, cnt, sizeof(glyph_t), compare_glyphs);
+    build_subset(&font, glyphs, cnt, &out);
+    write_font(&out, out_name, argv[i + 1], cnt, total, font.len);
+
+    fprintf(stderr, "%s: %zu of %zu glyphs, %zu -> %zu bytes, saved %zu "
+        "bytes (%.1f%%)\n", out_name, cnt, total, font.len, out.len,
+        (out.len < font.len) ? font.len - out.len : 0,
+        (out.len < font.len) ? 100.0 * (double)(font.len - out.len) /
+        (double)font.len : 0.0);
+
+    free(glyphs);
+    free(font.data);
+    free(out.data);
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
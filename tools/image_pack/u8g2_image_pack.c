@@ -0,0 +1,383 @@
+/***************************************************************************//**
+* @file    u8g2_image_pack.c
+* @version 1.0.0
+*
+* @brief Host tool converting XBM images to streamed image format.
+*
+* Reads XBM image (C source with _width and _height defines followed by
+* data bytes, e.g. GIMP export), converts it to page-major layout used by
+* SSD1306 display RAM, compresses it by run length encoding and writes C
+* source of the image for lib_u8g2_StreamImage() to stdout. Image size is
+* padded to whole 8x8 tiles. Size saving is reported to stderr.
+*
+* Build:
+*    gcc -O2 -o u8g2_image_pack u8g2_image_pack.c
+*
+* Usage:
+*    u8g2_image_pack [options] <image.xbm> > image.h
+*
+*    -n <name>   Name of generated array (default XBM name with _image)
+*    -r          Store raw data without compression
+*    -i          Invert pixels
+*
+* @author Jaroslav Groman
+*
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+/*******************************************************************************
+*   Macros and #define Constants
+*******************************************************************************/
+
+#define FORMAT_RAW              (0)     // LIB_U8G2_STREAM_RAW
+#define FORMAT_RLE              (1)     // LIB_U8G2_STREAM_RLE
+
+#define RLE_MAX_LITERAL         (128)
+#define RLE_MAX_RUN             (129)
+#define RLE_RUN_FLAG            (0x80)
+
+#define MAX_TILES               (255)
+#define NAME_SIZE               (128)
+#define OUTPUT_LINE_BYTES       (12)
+
+/*******************************************************************************
+* Private types
+*******************************************************************************/
+
+typedef struct
+{
+    uint8_t *data;
+    size_t len;
+    size_t size;
+} buffer_t;
+
+/*******************************************************************************
+* Private function definitions
+*******************************************************************************/
+
+static void
+fatal(const char *msg, const char *arg)
+{
+    fprintf(stderr, "u8g2_image_pack: %s%s%s\n", msg,
+        (arg != NULL) ? ": " : "", (arg != NULL) ? arg : "");
+    exit(EXIT_FAILURE);
+}
+
+static void
+buffer_add(buffer_t *buf, uint8_t byte)
+{
+    if (buf->len == buf->size)
+    {
+        buf->size = (buf->size == 0) ? 4096 : buf->size * 2;
+        buf->data = realloc(buf->data, buf->size);
+        if (buf->data == NULL)
+        {
+            fatal("out of memory", NULL);
+        }
+    }
+    buf->data[buf->len++] = byte;
+}
+
+static char *
+read_file(const char *path)
+{
+    FILE *fp;
+    char *text;
+    long len;
+
+    fp = fopen(path, "rb");
+    if (fp == NULL)
+    {
+        fatal("can not open file", path);
+    }
+
+    fseek(fp, 0, SEEK_END);
+    len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    text = malloc((size_t)len + 1);
+    if ((text == NULL) || (fread(text, 1, (size_t)len, fp) != (size_t)len))
+    {
+        fatal("can not read file", path);
+    }
+    text[len] = '\0';
+    fclose(fp);
+
+    return text;
+}
+
+/**
+ * Find "#define <name>_<suffix> <value>", store name prefix and return value.
+ */
+static long
+find_define(const char *text, const char *suffix, char *name)
+{
+    const char *p = text;
+    const char *p_name;
+    size_t len;
+    size_t suffix_len = strlen(suffix);
+
+    while ((p = strstr(p, "#define")) != NULL)
+    {
+        p += 7;
+        while ((*p == ' ') || (*p == '\t'))
+        {
+            p++;
+        }
+
+        p_name = p;
+        while (isalnum((unsigned char)*p) || (*p == '_'))
+        {
+            p++;
+        }
+        len = (size_t)(p - p_name);
+
+        if ((len > suffix_len) && (len - suffix_len < NAME_SIZE) &&
+            (strncmp(p - suffix_len, suffix, suffix_len) == 0))
+        {
+            memcpy(name, p_name, len - suffix_len);
+            name[len - suffix_len] = '\0';
+            return strtol(p, NULL, 0);
+        }
+    }
+
+    return -1;
+}
+
+static void
+load_xbm(const char *path, buffer_t *bits, long *p_width, long *p_height,
+    char *name)
+{
+    char *text = read_file(path);
+    const char *p;
+    char *p_end;
+    unsigned long val;
+
+    *p_width = find_define(text, "_width", name);
+    *p_height = find_define(text, "_height", name);
+    if ((*p_width <= 0) || (*p_height <= 0))
+    {
+        fatal("image size not found", path);
+    }
+    if ((*p_width > MAX_TILES * 8) || (*p_height > MAX_TILES * 8))
+    {
+        fatal("image too large", path);
+    }
+
+    p = strchr(text, '{');
+    if (p == NULL)
+    {
+        fatal("image data not found", path);
+    }
+
+    for (p++; (*p != '}') && (*p != '\0'); )
+    {
+        if ((p[0] == '0') && ((p[1] == 'x') || (p[1] == 'X')))
+        {
+            val = strtoul(p, &p_end, 16);
+            buffer_add(bits, (uint8_t)val);
+            p = p_end;
+        }
+        else
+        {
+            p++;
+        }
+    }
+
+    if (bits->len < (size_t)((*p_width + 7) / 8 * *p_height))
+    {
+        fatal("image data too short", path);
+    }
+
+    free(text);
+}
+
+/**
+ * Convert XBM rows (LSB is the left pixel) to pages of column bytes
+ * (LSB is the top pixel).
+ */
+static void
+to_pages(const buffer_t *bits, long width, long height, int is_invert,
+    buffer_t *pages)
+{
+    long stride = (width + 7) / 8;
+    long tiles_x = (width + 7) / 8;
+    long tiles_y = (height + 7) / 8;
+    uint8_t byte;
+    long y;
+
+    for (long page = 0; page < tiles_y; page++)
+    {
+        for (long x = 0; x < tiles_x * 8; x++)
+        {
+            byte = 0;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                y = page * 8 + bit;
+                if ((x < width) && (y < height) &&
+                    ((bits->data[y * stride + x / 8] >> (x % 8)) & 1))
+                {
+                    byte |= (uint8_t)(1u << bit);
+                }
+            }
+            buffer_add(pages, is_invert ? (uint8_t)~byte : byte);
+        }
+    }
+}
+
+static void
+rle_encode(const buffer_t *src, buffer_t *dst)
+{
+    size_t pos = 0;
+    size_t cnt;
+
+    while (pos < src->len)
+    {
+        cnt = 1;
+        while ((pos + cnt < src->len) && (cnt < RLE_MAX_RUN) &&
+            (src->data[pos + cnt] == src->data[pos]))
+        {
+            cnt++;
+        }
+
+        if (cnt >= 2)
+        {
+            buffer_add(dst, (uint8_t)(RLE_RUN_FLAG | (cnt - 2)));
+            buffer_add(dst, src->data[pos]);
+        }
+        else
+        {
+            // Literal bytes up to the start of next run
+            while ((pos + cnt < src->len) && (cnt < RLE_MAX_LITERAL) &&
+                !((pos + cnt + 1 < src->len) &&
+                (src->data[pos + cnt] == src->data[pos + cnt + 1])))
+            {
+                cnt++;
+            }
+
+            buffer_add(dst, (uint8_t)(cnt - 1));
+            for (size_t i = 0; i < cnt; i++)
+            {
+                buffer_add(dst, src->data[pos + i]);
+            }
+        }
+
+        pos += cnt;
+    }
+}
+
+static void
+write_image(const buffer_t *out, const char *name, const char *src_name,
+    long width, long height)
+{
+    printf("/*\n  Image %s created by u8g2_image_pack\n"
+        "  Size: %ldx%ld pixels, %zu bytes\n*/\n",
+        src_name, width, height, out->len);
+    printf("static const uint8_t %s[%zu] = {", name, out->len);
+
+    for (size_t i = 0; i < out->len; i++)
+    {
+        if (i % OUTPUT_LINE_BYTES == 0)
+        {
+            printf("\n   ");
+        }
+        printf(" 0x%02X%s", out->data[i], (i + 1 < out->len) ? "," : "");
+    }
+
+    printf("\n};\n");
+}
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+int
+main(int argc, char *argv[])
+{
+    buffer_t bits = { 0 };
+    buffer_t pages = { 0 };
+    buffer_t out = { 0 };
+    const char *out_name = NULL;
+    char xbm_name[NAME_SIZE];
+    char name_buf[NAME_SIZE + 8];
+    int is_raw = 0;
+    int is_invert = 0;
+    long width;
+    long height;
+    int i;
+
+    for (i = 1; (i < argc) && (argv[i][0] == '-'); i++)
+    {
+        if (argv[i][2] != '\0')
+        {
+            fatal("invalid option", argv[i]);
+        }
+
+        switch (argv[i][1])
+        {
+            case 'r': is_raw = 1; break;
+            case 'i': is_invert = 1; break;
+            case 'n':
+                if (i + 1 >= argc)
+                {
+                    fatal("invalid option", argv[i]);
+                }
+                out_name = argv[++i];
+            break;
+            default: fatal("invalid option", argv[i]); break;
+        }
+    }
+
+    if (argc - i != 1)
+    {
+        fprintf(stderr, "Usage: u8g2_image_pack [-n name] [-r] [-i] "
+            "<image.xbm>\n");
+        return EXIT_FAILURE;
+    }
+
+    load_xbm(argv[i], &bits, &width, &height, xbm_name);
+    to_pages(&bits, width, height, is_invert, &pages);
+
+    if (out_name == NULL)
+    {
+        snprintf(name_buf, sizeof(name_buf), "%s_image", xbm_name);
+        out_name = name_buf;
+    }
+
+    // Header, then data compressed only if it helps
+    buffer_add(&out, FORMAT_RLE);
+    buffer_add(&out, (uint8_t)((width + 7) / 8));
+    buffer_add(&out, (uint8_t)((height + 7) / 8));
+    if (!is_raw)
+    {
+        rle_encode(&pages, &out);
+    }
+    if (is_raw || (out.len - 3 >= pages.len))
+    {
+        out.data[0] = FORMAT_RAW;
+        out.len = 3;
+        for (size_t j = 0; j < pages.len; j++)
+        {
+            buffer_add(&out, pages.data[j]);
+        }
+    }
+
+    write_image(&out, out_name, argv[i], width, height);
+
+    fprintf(stderr, "%s: %ldx%ld, %zu data bytes -> %zu bytes (%s)\n",
+        out_name, width, height, pages.len, out.len,
+        (out.data[0] == FORMAT_RLE) ? "RLE" : "raw");
+
+    free(bits.data);
+    free(pages.data);
+    free(out.data);
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */